@@ -4,6 +4,10 @@
 #include <sstream>
 #include <algorithm>
 #include <functional>
+#include <thread>
+#include <atomic>
+#include <cmath>
+#include <chrono>
 
 using namespace std;
 
@@ -62,6 +66,153 @@ Parcel *CourierSystem::findParcel(int trackingID)
     return ptr ? *ptr : nullptr;
 }
 
+void CourierSystem::rebuildParcelIndex()
+{
+    for (int i = 0; i < allParcels.size(); i++)
+    {
+        parcelMap.insert(allParcels[i].trackingID, &allParcels[i]);
+    }
+}
+
+Rider *CourierSystem::findRider(int riderID)
+{
+    int *index = riderIndex.get(riderID);
+    return index ? &riders[*index] : nullptr;
+}
+
+void CourierSystem::rebuildRiderIndex()
+{
+    riderIndex.clear();
+    ridersByCity.clear();
+    ridersByCapacity = MinHeap<RiderSlot>();
+    parcelCarriers.clear();
+    rosterEntries.clear();
+    cityRosters.clear();
+    shiftTrees.clear();
+    shiftClockMinute = currentDispatchMinute();
+    riderStamp = Vector<int>(riders.size(), 0);
+    for (int i = 0; i < riders.size(); i++)
+    {
+        riderIndex.insert(riders[i].riderID, i);
+        for (int j = 0; j < riders[i].assignedParcels.size(); j++)
+        {
+            ParcelCarrier carrier = {riders[i].riderID, j};
+            parcelCarriers.insert(riders[i].assignedParcels[j], carrier);
+        }
+    }
+    for (int i = 0; i < riders.size(); i++)
+    {
+        touchRider(riders[i]);
+    }
+}
+
+void CourierSystem::touchRider(const Rider &rider)
+{
+    int *index = riderIndex.get(rider.riderID);
+    if (!index)
+        return;
+
+    placeOnRoster(rider);
+    int stamp = ++riderStamp[*index];
+    if (!isRiderOnShift(rider.riderID, shiftClockMinute))
+        return;
+
+    RiderSlot slot = {rider.getAvailableCapacity(), rider.riderID, stamp};
+    MinHeap<RiderSlot> *bucket = ridersByCity.get(rider.currentCityID);
+    if (!bucket)
+    {
+        ridersByCity.insert(rider.currentCityID, MinHeap<RiderSlot>());
+        bucket = ridersByCity.get(rider.currentCityID);
+    }
+    bucket->push(slot);
+    ridersByCapacity.push(slot);
+
+    if (ridersByCapacity.size() > 4 * riders.size() + 64)
+        rebuildRiderIndex();
+}
+
+void CourierSystem::placeOnRoster(const Rider &rider)
+{
+    RosterEntry *entry = rosterEntries.get(rider.riderID);
+    if (entry && entry->cityID == rider.currentCityID)
+        return;
+
+    if (entry)
+    {
+        Vector<int> &roster = *cityRosters.get(entry->cityID);
+        int last = roster.size() - 1;
+        if (entry->slot != last)
+        {
+            roster[entry->slot] = roster[last];
+            rosterEntries.get(roster[last])->slot = entry->slot;
+        }
+        roster.pop_back();
+        shiftTrees.remove(entry->cityID);
+    }
+
+    Vector<int> *roster = cityRosters.get(rider.currentCityID);
+    if (!roster)
+    {
+        cityRosters.insert(rider.currentCityID, Vector<int>());
+        roster = cityRosters.get(rider.currentCityID);
+    }
+    RosterEntry placed = {rider.currentCityID, roster->size()};
+    roster->push_back(rider.riderID);
+    rosterEntries.insert(rider.riderID, placed);
+    shiftTrees.remove(rider.currentCityID);
+}
+
+Rider *CourierSystem::findCarrier(int trackingID)
+{
+    ParcelCarrier *carrier = parcelCarriers.get(trackingID);
+    return carrier ? findRider(carrier->riderID) : nullptr;
+}
+
+void CourierSystem::attachParcel(Rider &rider, int trackingID)
+{
+    ParcelCarrier carrier = {rider.riderID, rider.assignedParcels.size()};
+    rider.assignedParcels.push_back(trackingID);
+    parcelCarriers.insert(trackingID, carrier);
+    riderTours.remove(rider.riderID);
+}
+
+Rider *CourierSystem::detachParcel(int trackingID)
+{
+    ParcelCarrier *carrier = parcelCarriers.get(trackingID);
+    if (!carrier)
+        return nullptr;
+
+    Rider *rider = findRider(carrier->riderID);
+    int slot = carrier->slot;
+    riderTours.remove(carrier->riderID);
+    parcelCarriers.remove(trackingID);
+    if (!rider)
+        return nullptr;
+
+    int last = rider->assignedParcels.size() - 1;
+    if (slot != last)
+    {
+        int moved = rider->assignedParcels[last];
+        rider->assignedParcels[slot] = moved;
+        parcelCarriers.get(moved)->slot = slot;
+    }
+    rider->assignedParcels.pop_back();
+    return rider;
+}
+
+int CourierSystem::bestRiderIn(MinHeap<RiderSlot> &bucket, int requiredCapacity)
+{
+    while (!bucket.empty())
+    {
+        RiderSlot top = bucket.top();
+        int *index = riderIndex.get(top.riderID);
+        if (index && riderStamp[*index] == top.stamp)
+            return top.available >= requiredCapacity ? top.riderID : -1;
+        bucket.pop();
+    }
+    return -1;
+}
+
 bool CourierSystem::validateCityID(int cityID) const
 {
     const Vector<Graph<City>::GraphNode> &nodes = cityMap.getNodes();
@@ -153,16 +304,75 @@ CourierSystem::CourierSystem()
 {
     nextTrackingID = 1001;
     nextRiderID = 1;
+    nextContainerID = 1;
+    graphVersion = 0;
+    overloadVersion = 0;
+    trafficAssignmentEnabled = false;
+    roadMatchingEnabled = false;
+    locationInbox = 0;
+    locationReader = nullptr;
+    dispatchClock = -1;
+    shiftClockMinute = currentDispatchMinute();
+    locationStreamRunning = false;
+    locationLinesRead = 0;
+    locationMalformed = 0;
+    locationCoalesced = 0;
+    locationApplied = 0;
+    locationRejected = 0;
+    locationBatches = 0;
+    assignmentVersion = -1;
+    networkTransactionDepth = 0;
+    pendingNetworkChanges = 0;
+    pendingFullReroute = false;
+    connectivityDirty = true;
+    connectivityVersion = 0;
+    vulnerabilityVersion = -1;
+    serviceAreaVersion = -1;
+    routingVersion = -1;
+    routingOverloadVersion = -1;
     initializeAdmins();
 }
 
+CourierSystem::~CourierSystem()
+{
+    if (locationReader)
+    {
+        locationStreamRunning = false;
+        locationReader->join();
+        delete locationReader;
+    }
+}
+
 void CourierSystem::loadData()
 {
     loadAdmins();
     CSVUtils::loadCities("cities.csv", cityMap);
     CSVUtils::loadRoutes("routes.csv", cityMap);
+    CSVUtils::loadHubs("hubs.csv", hubCities);
+    rebuildLocators();
+    CSVUtils::loadTravelTimes("travel_times.csv", cityMap, travelTimes);
+    loadEdgeCapacities("edge_capacities.csv");
+    roadNetwork.rebuild(cityMap, OverlayGraph::NodeOrder::ReverseCuthillMcKee);
+    connectivityDirty = true;
     CSVUtils::loadRiders("riders.csv", riders, nextRiderID);
+    CSVUtils::loadShifts("shifts.csv", riderShifts);
+    Vector<int> scheduled = riderShifts.getAllKeys();
+    for (int i = 0; i < scheduled.size(); i++)
+    {
+        rebuildAvailability(scheduled[i]);
+    }
+    rebuildShiftBoundaries();
+    rebuildRiderIndex();
     CSVUtils::loadParcels("parcels.csv", allParcels, parcelMap, nextTrackingID);
+    rebuildParcelIndex();
+    CSVUtils::loadContainers("containers.csv", containers, nextContainerID);
+    rebuildContainerIndex();
+    Vector<ContainerEvent> journal;
+    CSVUtils::loadContainerJournal("container_journal.csv", journal);
+    for (int i = 0; i < journal.size(); i++)
+    {
+        applyContainerEvent(journal[i]);
+    }
 
     for (int i = 0; i < allParcels.size(); i++)
     {
@@ -176,6 +386,7 @@ void CourierSystem::loadData()
         }
         else if (allParcels[i].status == Status::InTransit)
         {
+            setParcelRoute(allParcels[i], allParcels[i].routeID);
             transitQueue.push(allParcels[i]);
         }
     }
@@ -200,8 +411,13 @@ void CourierSystem::addParcel(string sender, string receiver, Priority priority,
 
     pickupQueue.push(newParcel);
 
+    Parcel *previousStorage = allParcels.empty() ? nullptr : allParcels.begin();
     allParcels.push_back(newParcel);
 
+    if (previousStorage && previousStorage != allParcels.begin())
+    {
+        rebuildParcelIndex();
+    }
     parcelMap.insert(newParcel.trackingID, &allParcels[allParcels.size() - 1]);
 
     CSVUtils::saveParcel("parcels.csv", newParcel);
@@ -233,26 +449,16 @@ bool CourierSystem::removeParcel(int trackingID)
     {
         removedFromQueue = transitQueue.remove(*parcel);
 
-        for (int i = 0; i < riders.size(); i++)
+        Rider *rider = detachParcel(trackingID);
+        if (rider)
         {
-            for (int j = 0; j < riders[i].assignedParcels.size(); j++)
-            {
-                if (riders[i].assignedParcels[j] == trackingID)
-                {
-                    riders[i].currentLoad -= parcel->weight;
-
-                    for (int k = j; k < riders[i].assignedParcels.size() - 1; k++)
-                    {
-                        riders[i].assignedParcels[k] = riders[i].assignedParcels[k + 1];
-                    }
-                    riders[i].assignedParcels.pop_back();
-                    break;
-                }
-            }
+            rider->currentLoad -= parcel->weight;
+            touchRider(*rider);
         }
     }
 
     string prevState = parcel->getStatusStr();
+    releaseParcelRoute(*parcel);
     parcel->status = Status::Returned;
     parcel->history.push_back(getCurrentTimestamp() + " - Parcel Withdrawn");
 
@@ -272,6 +478,21 @@ bool CourierSystem::removeParcel(int trackingID)
 }
 
 void CourierSystem::addCity(string name)
+{
+    addCityRecord(name, false, 0, 0);
+}
+
+void CourierSystem::addCity(string name, double latitude, double longitude)
+{
+    if (latitude < -90 || latitude > 90 || longitude < -180 || longitude > 180)
+    {
+        PRINT_ERROR("Coordinates out of range.\n");
+        return;
+    }
+    addCityRecord(name, true, latitude, longitude);
+}
+
+void CourierSystem::addCityRecord(const string &name, bool located, double latitude, double longitude)
 {
     if (name.empty())
     {
@@ -288,10 +509,18 @@ void CourierSystem::addCity(string name)
     }
     int newID = maxID + 1;
 
-    cityMap.addNode(newID, City(newID, name));
-    CSVUtils::saveCity("cities.csv", newID, name);
+    City city = located ? City(newID, name, latitude, longitude) : City(newID, name);
+    storeCity(city);
+    CSVUtils::saveCity("cities.csv", city);
+    if (located)
+    {
+        double point[3];
+        toUnitVector(latitude, longitude, point);
+        cityLocator.insert(newID, point);
+    }
+    connectivityAddCity(newID);
 
-    recalculateActiveRoutes();
+    onNetworkChanged(false);
 
     PRINT_SUCCESS("City '" << name << "' added with ID: " << newID << "\n");
 }
@@ -310,32 +539,48 @@ void CourierSystem::addRoute(int srcID, int destID, int distance)
         return;
     }
 
-    cityMap.addEdge(srcID, destID, distance);
-    cityMap.addEdge(destID, srcID, distance);
+    storeRoad(srcID, destID, distance);
     CSVUtils::saveRoute("routes.csv", srcID, destID, distance);
+    connectivityOpenEdge(srcID, destID);
 
-    recalculateActiveRoutes();
+    onNetworkChanged();
 
     PRINT_SUCCESS("Route added between " << srcID << " and " << destID << "\n");
 }
 
+void CourierSystem::storeCity(const City &city)
+{
+    cityMap.addNode(city.id, city);
+    roadNetwork.addNode(city.id);
+}
+
+void CourierSystem::storeRoad(int srcID, int destID, int distance)
+{
+    cityMap.addEdge(srcID, destID, distance);
+    cityMap.addEdge(destID, srcID, distance);
+    roadNetwork.setEdge(srcID, destID, distance);
+    roadNetwork.setEdge(destID, srcID, distance);
+}
+
 int CourierSystem::calculateShortestPath(int srcID, int destID, Vector<int> &path, bool avoidBlocked)
 {
-    const int MAX_ID = 1000;
-    int dist[MAX_ID];
-    int parent[MAX_ID];
-    bool visited[MAX_ID];
+    if (!areCitiesConnected(srcID, destID, avoidBlocked))
+        return -1;
 
-    for (int i = 0; i < MAX_ID; i++)
-    {
-        dist[i] = 999999;
-        parent[i] = -1;
-        visited[i] = false;
-    }
+    OverlayGraph::View roads = roadNetwork.acquire();
+    int source = roads.indexOf(srcID);
+    int target = roads.indexOf(destID);
+    if (source == -1 || target == -1)
+        return -1;
 
-    dist[srcID] = 0;
+    const int n = roads.nodeCount();
+    Vector<int> dist(n, 999999);
+    Vector<int> parent(n, -1);
+    Vector<bool> visited(n, false);
+
+    dist[source] = 0;
     MinHeap<DijkstraNode> pq;
-    pq.push({srcID, 0});
+    pq.push({source, 0});
 
     while (!pq.empty())
     {
@@ -353,26 +598,22 @@ int CourierSystem::calculateShortestPath(int srcID, int destID, Vector<int> &pat
 
         visited[u] = true;
 
-        if (u == destID)
+        if (u == target)
             break;
 
-        LinkedList<Graph<City>::Edge> *neighbors = cityMap.getNeighbors(u);
-        if (!neighbors)
-            continue;
-
-        for (auto &edge : *neighbors)
+        int uID = roads.idAt(u);
+        auto relax = [&](int v, int weight)
         {
-            int v = edge.destID;
-            int weight = edge.weight;
+            int vID = roads.idAt(v);
 
-            if (avoidBlocked && isEdgeBlocked(u, v))
+            if (avoidBlocked && isEdgeBlocked(uID, vID))
             {
-                continue;
+                return;
             }
 
-            if (avoidBlocked && this->isPathOverloaded(u, v))
+            if (avoidBlocked && this->isPathOverloaded(uID, vID))
             {
-                continue;
+                return;
             }
 
             int newDist = dist[u] + weight;
@@ -382,17 +623,18 @@ int CourierSystem::calculateShortestPath(int srcID, int destID, Vector<int> &pat
                 parent[v] = u;
                 pq.push({v, dist[v]});
             }
-        }
+        };
+        roads.forEachNeighbor(u, relax);
     }
 
-    if (dist[destID] == 999999)
+    if (dist[target] == 999999)
         return -1;
 
     path.clear();
-    int curr = destID;
+    int curr = target;
     while (curr != -1)
     {
-        path.push_back(curr);
+        path.push_back(roads.idAt(curr));
         curr = parent[curr];
     }
 
@@ -403,14 +645,109 @@ int CourierSystem::calculateShortestPath(int srcID, int destID, Vector<int> &pat
     }
     path = reversedPath;
 
-    return dist[destID];
+    return dist[target];
+}
+
+int CourierSystem::edgeTravelSeconds(const Graph<City>::Edge &edge, int secondOfDay) const
+{
+    if (edge.profileID >= 0 && edge.profileID < travelTimes.profileCount())
+    {
+        return travelTimes.travelSeconds(edge.profileID, secondOfDay);
+    }
+    return TravelTimeTable::freeFlowSeconds(edge.weight);
+}
+
+int CourierSystem::calculateTimeDependentPath(int srcID, int destID, time_t departure, Vector<int> &path, bool avoidBlocked)
+{
+    int source = cityMap.indexOf(srcID);
+    int target = cityMap.indexOf(destID);
+    if (source == -1 || target == -1)
+        return -1;
+
+    Vector<Graph<City>::GraphNode> &nodes = cityMap.getNodes();
+    const int n = nodes.size();
+    Vector<int> dist(n, 2147483647);
+    Vector<int> parent(n, -1);
+    Vector<bool> visited(n, false);
+
+    tm *departureInfo = localtime(&departure);
+    int departureSecond = departureInfo->tm_hour * 3600 + departureInfo->tm_min * 60 + departureInfo->tm_sec;
+
+    dist[source] = 0;
+    MinHeap<DijkstraNode> pq;
+    pq.push({source, 0});
+
+    while (!pq.empty())
+    {
+        DijkstraNode current = pq.top();
+        pq.pop();
+
+        int u = current.id;
+        if (visited[u] || current.dist > dist[u])
+            continue;
+
+        visited[u] = true;
+        if (u == target)
+            break;
+
+        int uID = nodes[u].id;
+        int secondOfDay = (departureSecond + dist[u]) % TravelTimeTable::SECONDS_PER_DAY;
+        for (auto &edge : nodes[u].adjacencyList)
+        {
+            int v = cityMap.indexOf(edge.destID);
+            if (v == -1)
+                continue;
+            if (avoidBlocked && (isEdgeBlocked(uID, edge.destID) || isPathOverloaded(uID, edge.destID)))
+            {
+                continue;
+            }
+
+            int arrival = dist[u] + edgeTravelSeconds(edge, secondOfDay);
+            if (arrival < dist[v])
+            {
+                dist[v] = arrival;
+                parent[v] = u;
+                pq.push({v, arrival});
+            }
+        }
+    }
+
+    if (dist[target] == 2147483647)
+        return -1;
+
+    path.clear();
+    Vector<int> reversedPath;
+    for (int curr = target; curr != -1; curr = parent[curr])
+    {
+        reversedPath.push_back(nodes[curr].id);
+    }
+    for (int i = reversedPath.size() - 1; i >= 0; i--)
+    {
+        path.push_back(reversedPath[i]);
+    }
+
+    return dist[target];
 }
 
 void CourierSystem::displayRoute(int srcID, int destID)
 {
     Vector<int> path;
 
-    int distance = calculateShortestPath(srcID, destID, path, true);
+    if (!areCitiesConnected(srcID, destID, false))
+    {
+        PRINT_ERROR("No route found between these cities.\n");
+        return;
+    }
+
+    int distance = -1;
+    if (areCitiesConnected(srcID, destID))
+    {
+        distance = calculateShortestPath(srcID, destID, path, true);
+    }
+    else
+    {
+        PRINT_WARNING("Destination is cut off by road closures. Showing route through blocked roads.\n");
+    }
 
     if (distance == -1 || path.size() == 0)
     {
@@ -466,6 +803,79 @@ void CourierSystem::displayRoute(int srcID, int destID)
     }
 }
 
+void CourierSystem::displayTimeDependentRoute(int srcID, int destID, int departureHour, int departureMinute)
+{
+    if (!validateRoute(srcID, destID))
+    {
+        PRINT_ERROR("Invalid city IDs.\n");
+        return;
+    }
+
+    if (departureHour < 0 || departureHour > 23 || departureMinute < 0 || departureMinute > 59)
+    {
+        PRINT_ERROR("Departure time must be between 00:00 and 23:59.\n");
+        return;
+    }
+
+    time_t now = time(0);
+    tm departureInfo = *localtime(&now);
+    departureInfo.tm_hour = departureHour;
+    departureInfo.tm_min = departureMinute;
+    departureInfo.tm_sec = 0;
+    time_t departure = mktime(&departureInfo);
+
+    Vector<int> path;
+    int seconds = calculateTimeDependentPath(srcID, destID, departure, path, true);
+    if (seconds == -1)
+    {
+        PRINT_ERROR("No open route found between these cities.\n");
+        return;
+    }
+
+    int distance = 0;
+    for (int i = 0; i + 1 < path.size(); i++)
+    {
+        LinkedList<Graph<City>::Edge> *neighbors = cityMap.getNeighbors(path[i]);
+        if (!neighbors)
+            continue;
+        for (auto &edge : *neighbors)
+        {
+            if (edge.destID == path[i + 1])
+            {
+                distance += edge.weight;
+                break;
+            }
+        }
+    }
+
+    time_t arrival = departure + seconds;
+    tm arrivalInfo = *localtime(&arrival);
+    ostringstream departStr, arriveStr;
+    departStr << put_time(&departureInfo, "%H:%M");
+    arriveStr << put_time(&arrivalInfo, "%H:%M");
+    int daysLater = (departureHour * 3600 + departureMinute * 60 + seconds) / TravelTimeTable::SECONDS_PER_DAY;
+    if (daysLater > 0)
+        arriveStr << " (+" << daysLater << "d)";
+
+    cout << "\n=== Fastest Route (Departing " << departStr.str() << ") ===\n";
+    cout << BRIGHT_GREEN << "Travel Time: " << BRIGHT_YELLOW << (seconds / 3600) << "h " << ((seconds % 3600) / 60) << "m" << RESET << "\n";
+    cout << BRIGHT_GREEN << "Estimated Arrival: " << BRIGHT_YELLOW << arriveStr.str() << RESET << "\n";
+    cout << BRIGHT_GREEN << "Distance: " << BRIGHT_YELLOW << distance << " km" << RESET << "\n";
+    cout << BRIGHT_BLUE << "Path: " << RESET;
+    for (int i = 0; i < path.size(); i++)
+    {
+        City *c = cityMap.getNodeData(path[i]);
+        if (c)
+            cout << BRIGHT_CYAN << c->name << RESET;
+        else
+            cout << path[i];
+
+        if (i < path.size() - 1)
+            cout << BRIGHT_YELLOW << " -> " << RESET;
+    }
+    cout << "\n";
+}
+
 void CourierSystem::viewAllRoutes(int srcID, int destID)
 {
     if (!validateRoute(srcID, destID))
@@ -577,6 +987,7 @@ void CourierSystem::findKShortestPaths(int srcID, int destID, int k, Vector<Vect
     distances.clear();
 
     Vector<BlockedEdge> originalBlockedEdges = blockedEdges;
+    OverlayGraph::View roads = roadNetwork.acquire();
 
     auto isEdgeBlockedLocal = [&](int s, int d, const Vector<BlockedEdge> &blockedList) -> bool
     {
@@ -594,21 +1005,19 @@ void CourierSystem::findKShortestPaths(int srcID, int destID, int k, Vector<Vect
 
     auto calculateWithLocalBlocked = [&](int src, int dest, Vector<int> &path, const Vector<BlockedEdge> &localBlocked) -> int
     {
-        const int MAX_ID = 1000;
-        int dist[MAX_ID];
-        int parent[MAX_ID];
-        bool visited[MAX_ID];
+        int source = roads.indexOf(src);
+        int target = roads.indexOf(dest);
+        if (source == -1 || target == -1)
+            return -1;
 
-        for (int i = 0; i < MAX_ID; i++)
-        {
-            dist[i] = 999999;
-            parent[i] = -1;
-            visited[i] = false;
-        }
+        const int n = roads.nodeCount();
+        Vector<int> dist(n, 999999);
+        Vector<int> parent(n, -1);
+        Vector<bool> visited(n, false);
 
-        dist[src] = 0;
+        dist[source] = 0;
         MinHeap<DijkstraNode> pq;
-        pq.push({src, 0});
+        pq.push({source, 0});
 
         while (!pq.empty())
         {
@@ -624,26 +1033,22 @@ void CourierSystem::findKShortestPaths(int srcID, int destID, int k, Vector<Vect
                 continue;
 
             visited[u] = true;
-            if (u == dest)
+            if (u == target)
                 break;
 
-            LinkedList<Graph<City>::Edge> *neighbors = cityMap.getNeighbors(u);
-            if (!neighbors)
-                continue;
-
-            for (auto &edge : *neighbors)
+            int uID = roads.idAt(u);
+            auto relax = [&](int v, int weight)
             {
-                int v = edge.destID;
-                int weight = edge.weight;
+                int vID = roads.idAt(v);
 
-                if (isEdgeBlockedLocal(u, v, localBlocked))
+                if (isEdgeBlockedLocal(uID, vID, localBlocked))
                 {
-                    continue;
+                    return;
                 }
 
-                if (this->isPathOverloaded(u, v))
+                if (this->isPathOverloaded(uID, vID))
                 {
-                    continue;
+                    return;
                 }
 
                 int newDist = dist[u] + weight;
@@ -653,17 +1058,18 @@ void CourierSystem::findKShortestPaths(int srcID, int destID, int k, Vector<Vect
                     parent[v] = u;
                     pq.push({v, dist[v]});
                 }
-            }
+            };
+            roads.forEachNeighbor(u, relax);
         }
 
-        if (dist[dest] == 999999)
+        if (dist[target] == 999999)
             return -1;
 
         path.clear();
-        int curr = dest;
+        int curr = target;
         while (curr != -1)
         {
-            path.push_back(curr);
+            path.push_back(roads.idAt(curr));
             curr = parent[curr];
         }
 
@@ -674,7 +1080,7 @@ void CourierSystem::findKShortestPaths(int srcID, int destID, int k, Vector<Vect
         }
         path = reversedPath;
 
-        return dist[dest];
+        return dist[target];
     };
 
     Vector<int> firstPath;
@@ -773,38 +1179,200 @@ void CourierSystem::calculateAlternativeRoutes(int srcID, int destID, int k, Vec
     findKShortestPaths(srcID, destID, k, routes, distances);
 }
 
-void CourierSystem::displayAlternativeRoutes(int srcID, int destID, int count)
+void CourierSystem::calculateParetoRoutes(int srcID, int destID, int maxRoutes, Vector<ParetoRoute> &frontier)
 {
-    Vector<Vector<int>> routes;
-    Vector<int> distances;
+    const int MAX_LABELS_PER_NODE = 32;
+    frontier.clear();
 
-    calculateAlternativeRoutes(srcID, destID, count, routes, distances);
-
-    if (routes.size() == 0)
-    {
-        cout << "\n[ERROR] No routes found between these cities.\n";
+    OverlayGraph::View roads = roadNetwork.acquire();
+    int source = roads.indexOf(srcID);
+    int target = roads.indexOf(destID);
+    if (maxRoutes < 1 || source == -1 || target == -1)
         return;
-    }
 
-    cout << "\n=== Alternative Routes (" << routes.size() << " found) ===\n";
-    for (int i = 0; i < routes.size(); i++)
+    Vector<ParetoLabel> labels;
+    Vector<Vector<int>> nodeLabels(roads.nodeCount(), Vector<int>());
+    Vector<int> targetLabels;
+
+    labels.push_back({source, 0, 0, -1, true});
+    nodeLabels[source].push_back(0);
+    MinHeap<ParetoQueueEntry> pq;
+    pq.push({0, 0, 0});
+
+    while (!pq.empty())
     {
-        cout << "\nRoute " << (i + 1) << " - Distance: " << distances[i] << " km\n";
-        cout << "Path: ";
-        for (int j = 0; j < routes[i].size(); j++)
-        {
-            City *c = cityMap.getNodeData(routes[i][j]);
-            if (c)
-                cout << c->name;
-            else
-                cout << routes[i][j];
+        ParetoQueueEntry entry = pq.top();
+        pq.pop();
 
-            if (j < routes[i].size() - 1)
-                cout << " -> ";
-        }
-        cout << "\n";
-    }
-}
+        if (!labels[entry.label].active)
+            continue;
+
+        int u = labels[entry.label].node;
+        if (u == target)
+        {
+            targetLabels.push_back(entry.label);
+            continue;
+        }
+
+        int uID = roads.idAt(u);
+        auto extend = [&](int v, int weight)
+        {
+            int vID = roads.idAt(v);
+            if (isEdgeBlocked(uID, vID))
+                return;
+
+            int newDist = entry.dist + weight;
+            int newLoad = entry.load + getEdgeLoadPermille(uID, vID);
+
+            bool dominated = false;
+            for (int i = 0; i < targetLabels.size() && !dominated; i++)
+            {
+                const ParetoLabel &t = labels[targetLabels[i]];
+                dominated = t.dist <= newDist && t.load <= newLoad;
+            }
+
+            Vector<int> &existing = nodeLabels[v];
+            for (int i = 0; i < existing.size() && !dominated; i++)
+            {
+                const ParetoLabel &l = labels[existing[i]];
+                dominated = l.active && l.dist <= newDist && l.load <= newLoad;
+            }
+            if (dominated)
+                return;
+
+            int kept = 0;
+            for (int i = 0; i < existing.size(); i++)
+            {
+                ParetoLabel &l = labels[existing[i]];
+                if (l.active && newDist <= l.dist && newLoad <= l.load)
+                {
+                    l.active = false;
+                }
+                if (l.active)
+                {
+                    existing[kept++] = existing[i];
+                }
+            }
+            while (existing.size() > kept)
+            {
+                existing.pop_back();
+            }
+            if (existing.size() >= MAX_LABELS_PER_NODE)
+                return;
+
+            labels.push_back({v, newDist, newLoad, entry.label, true});
+            int labelID = labels.size() - 1;
+            existing.push_back(labelID);
+            pq.push({newDist, newLoad, labelID});
+        };
+        roads.forEachNeighbor(u, extend);
+    }
+
+    int total = targetLabels.size();
+    for (int i = 0; i < total; i++)
+    {
+        if (total > maxRoutes && maxRoutes > 1)
+        {
+            bool keep = false;
+            for (int slot = 0; slot < maxRoutes && !keep; slot++)
+            {
+                keep = (slot * (total - 1)) / (maxRoutes - 1) == i;
+            }
+            if (!keep)
+                continue;
+        }
+        else if (total > maxRoutes && i > 0)
+        {
+            break;
+        }
+
+        ParetoRoute route;
+        route.distance = labels[targetLabels[i]].dist;
+        route.loadPermille = labels[targetLabels[i]].load;
+
+        Vector<int> reversedPath;
+        for (int l = targetLabels[i]; l != -1; l = labels[l].parent)
+        {
+            reversedPath.push_back(roads.idAt(labels[l].node));
+        }
+        for (int j = reversedPath.size() - 1; j >= 0; j--)
+        {
+            route.path.push_back(reversedPath[j]);
+        }
+        frontier.push_back(route);
+    }
+}
+
+void CourierSystem::displayAlternativeRoutes(int srcID, int destID, int count, bool showTradeoffs)
+{
+    if (showTradeoffs)
+    {
+        Vector<ParetoRoute> frontier;
+        calculateParetoRoutes(srcID, destID, count, frontier);
+
+        if (frontier.size() == 0)
+        {
+            cout << "\n[ERROR] No routes found between these cities.\n";
+            return;
+        }
+
+        Table t;
+        t.addHeader("Route");
+        t.addHeader("Distance (km)");
+        t.addHeader("Congestion");
+        t.addHeader("Path");
+
+        for (int i = 0; i < frontier.size(); i++)
+        {
+            string pathStr;
+            for (int j = 0; j < frontier[i].path.size(); j++)
+            {
+                City *c = cityMap.getNodeData(frontier[i].path[j]);
+                pathStr += c ? c->name : to_string(frontier[i].path[j]);
+                if (j < frontier[i].path.size() - 1)
+                    pathStr += " -> ";
+            }
+            ostringstream congestion;
+            congestion << fixed << setprecision(2) << (frontier[i].loadPermille / 1000.0);
+            t.addRow({to_string(i + 1), to_string(frontier[i].distance), congestion.str(), pathStr});
+        }
+
+        cout << "\n=== Route Trade-offs: Distance vs Congestion (" << frontier.size() << " Pareto-optimal) ===\n";
+        t.print();
+        cout << "Congestion is the sum of load/capacity over the route's segments.\n";
+        return;
+    }
+
+    Vector<Vector<int>> routes;
+    Vector<int> distances;
+
+    calculateAlternativeRoutes(srcID, destID, count, routes, distances);
+
+    if (routes.size() == 0)
+    {
+        cout << "\n[ERROR] No routes found between these cities.\n";
+        return;
+    }
+
+    cout << "\n=== Alternative Routes (" << routes.size() << " found) ===\n";
+    for (int i = 0; i < routes.size(); i++)
+    {
+        cout << "\nRoute " << (i + 1) << " - Distance: " << distances[i] << " km\n";
+        cout << "Path: ";
+        for (int j = 0; j < routes[i].size(); j++)
+        {
+            City *c = cityMap.getNodeData(routes[i][j]);
+            if (c)
+                cout << c->name;
+            else
+                cout << routes[i][j];
+
+            if (j < routes[i].size() - 1)
+                cout << " -> ";
+        }
+        cout << "\n";
+    }
+}
 
 void CourierSystem::blockRoute(int srcID, int destID)
 {
@@ -815,17 +1383,19 @@ void CourierSystem::blockRoute(int srcID, int destID)
             (blockedEdges[i].srcID == destID && blockedEdges[i].destID == srcID))
         {
             blockedEdges[i].isBlocked = true;
+            connectivityCloseEdge(srcID, destID);
             cout << "\n[SUCCESS] Route already in blocked list, marked as blocked.\n";
-            recalculateActiveRoutes();
+            onEdgeDegraded(srcID, destID);
             return;
         }
     }
 
     blockedEdges.push_back(BlockedEdge(srcID, destID, true));
+    connectivityCloseEdge(srcID, destID);
     logOperation(OperationType::BlockRoute, -1, "Open", "Blocked", -1, srcID, destID);
 
     cout << "\n[SUCCESS] Route between " << srcID << " and " << destID << " blocked.\n";
-    recalculateActiveRoutes();
+    onEdgeDegraded(srcID, destID);
 }
 
 void CourierSystem::unblockRoute(int srcID, int destID)
@@ -836,957 +1406,5945 @@ void CourierSystem::unblockRoute(int srcID, int destID)
             (blockedEdges[i].srcID == destID && blockedEdges[i].destID == srcID))
         {
             blockedEdges[i].isBlocked = false;
+            connectivityOpenEdge(srcID, destID);
             logOperation(OperationType::UnblockRoute, -1, "Blocked", "Open", -1, srcID, destID);
             cout << "\n[SUCCESS] Route between " << srcID << " and " << destID << " unblocked.\n";
-            recalculateActiveRoutes();
+            onNetworkChanged();
             return;
         }
     }
     cout << "\n[INFO] Route not found in blocked list.\n";
 }
 
-void CourierSystem::displayBlockedRoutes()
+int CourierSystem::connectivityIndexOf(int cityID) const
 {
-    Table t;
-    t.addHeader("Source ID");
-    t.addHeader("Destination ID");
-    t.addHeader("Status");
+    const int *index = cityIndex.get(cityID);
+    return index ? *index : -1;
+}
 
-    bool hasBlocked = false;
-    for (int i = 0; i < blockedEdges.size(); i++)
-    {
-        if (blockedEdges[i].isBlocked)
-        {
-            hasBlocked = true;
-            City *src = cityMap.getNodeData(blockedEdges[i].srcID);
-            City *dest = cityMap.getNodeData(blockedEdges[i].destID);
-            string srcName = src ? src->name : to_string(blockedEdges[i].srcID);
-            string destName = dest ? dest->name : to_string(blockedEdges[i].destID);
-            t.addRow({srcName, destName, "Blocked"});
-        }
-    }
+void CourierSystem::rebuildConnectivity()
+{
+    Vector<Graph<City>::GraphNode> &nodes = cityMap.getNodes();
+    cityIndex.clear();
+    forestEdges.clear();
+    openComponents.reset(nodes.size());
+    roadComponents.reset(nodes.size());
 
-    if (!hasBlocked)
+    for (int i = 0; i < nodes.size(); i++)
     {
-        cout << "\n[INFO] No blocked routes.\n";
-        return;
+        cityIndex.insert(nodes[i].id, i);
     }
 
-    cout << "\n=== Blocked Routes ===\n";
-    t.print();
-}
-
-void CourierSystem::recalculateActiveRoutes()
-{
-    int count = 0;
-    for (int i = 0; i < allParcels.size(); i++)
+    for (int i = 0; i < nodes.size(); i++)
     {
-        if (allParcels[i].status == Status::InTransit)
+        for (auto &edge : nodes[i].adjacencyList)
         {
-            Vector<int> newPath;
+            int j = connectivityIndexOf(edge.destID);
+            if (j == -1)
+                continue;
 
-            int startCity = (allParcels[i].currentCityID != -1) ? allParcels[i].currentCityID : allParcels[i].sourceCityID;
-            int dist = calculateShortestPath(startCity, allParcels[i].destCityID, newPath, true);
-            if (dist != -1)
+            roadComponents.unite(i, j);
+            if (!isEdgeBlocked(nodes[i].id, edge.destID) && openComponents.unite(i, j))
             {
-
-                allParcels[i].currentRoute = newPath;
-                allParcels[i].history.push_back(getCurrentTimestamp() + " - Route recalculated due to network change");
-                count++;
+                forestEdges.insert(edgeKey(nodes[i].id, edge.destID), 1);
             }
         }
     }
-    if (count > 0)
-    {
-        cout << "\n[INFO] Recalculated routes for " << count << " parcels in transit.\n";
-    }
+
+    connectivityDirty = false;
+    connectivityVersion++;
 }
 
-void CourierSystem::markPathAsOverloaded(int srcID, int destID, int load)
+void CourierSystem::connectivityAddCity(int cityID)
 {
-    if (!validateRoute(srcID, destID))
-    {
-        cout << "\n[ERROR] Invalid route.\n";
+    if (connectivityDirty || cityIndex.contains(cityID))
         return;
-    }
 
-    for (int i = 0; i < overloadedEdges.size(); i++)
+    cityIndex.insert(cityID, openComponents.add());
+    roadComponents.add();
+    connectivityVersion++;
+}
+
+void CourierSystem::connectivityOpenEdge(int srcID, int destID)
+{
+    if (connectivityDirty)
+        return;
+
+    int i = connectivityIndexOf(srcID);
+    int j = connectivityIndexOf(destID);
+    if (i == -1 || j == -1 || isEdgeBlocked(srcID, destID))
+        return;
+
+    bool hasRoad = false;
+    LinkedList<Graph<City>::Edge> *neighbors = cityMap.getNeighbors(srcID);
+    if (neighbors)
     {
-        if ((overloadedEdges[i].srcID == srcID && overloadedEdges[i].destID == destID) ||
-            (overloadedEdges[i].srcID == destID && overloadedEdges[i].destID == srcID))
+        for (auto &edge : *neighbors)
         {
-            overloadedEdges[i].currentLoad = load;
-            if (load >= overloadedEdges[i].maxCapacity)
+            if (edge.destID == destID)
             {
-                cout << "\n[WARNING] Path is at or over capacity! Consider blocking.\n";
+                hasRoad = true;
+                break;
             }
-            recalculateActiveRoutes();
-            return;
         }
     }
+    if (!hasRoad)
+        return;
 
-    overloadedEdges.push_back(OverloadedEdge(srcID, destID, load, 100));
-    cout << "\n[SUCCESS] Path marked as overloaded (Load: " << load << "/100).\n";
-    recalculateActiveRoutes();
+    roadComponents.unite(i, j);
+    if (openComponents.unite(i, j))
+    {
+        forestEdges.insert(edgeKey(srcID, destID), 1);
+    }
+    connectivityVersion++;
 }
 
-void CourierSystem::unmarkPathAsOverloaded(int srcID, int destID)
+void CourierSystem::connectivityCloseEdge(int srcID, int destID)
 {
-    for (int i = 0; i < overloadedEdges.size(); i++)
+    if (forestEdges.contains(edgeKey(srcID, destID)))
     {
-        if ((overloadedEdges[i].srcID == srcID && overloadedEdges[i].destID == destID) ||
-            (overloadedEdges[i].srcID == destID && overloadedEdges[i].destID == srcID))
-        {
-
-            for (int j = i; j < overloadedEdges.size() - 1; j++)
-            {
-                overloadedEdges[j] = overloadedEdges[j + 1];
-            }
-            overloadedEdges.pop_back();
-            cout << "\n[SUCCESS] Path overload status removed.\n";
-            recalculateActiveRoutes();
-            return;
-        }
+        connectivityDirty = true;
     }
-    cout << "\n[INFO] Path not found in overloaded list.\n";
+    connectivityVersion++;
 }
 
-bool CourierSystem::isPathOverloaded(int srcID, int destID) const
+bool CourierSystem::areCitiesConnected(int srcID, int destID, bool underClosures)
 {
-    for (int i = 0; i < overloadedEdges.size(); i++)
+    if (connectivityDirty)
+        rebuildConnectivity();
+
+    int i = connectivityIndexOf(srcID);
+    int j = connectivityIndexOf(destID);
+    if (i == -1 || j == -1)
+        return false;
+
+    return underClosures ? openComponents.connected(i, j) : roadComponents.connected(i, j);
+}
+
+void CourierSystem::computeVulnerabilities()
+{
+    if (connectivityDirty)
+        rebuildConnectivity();
+    if (vulnerabilityVersion == connectivityVersion)
+        return;
+
+    Vector<Graph<City>::GraphNode> &nodes = cityMap.getNodes();
+    int n = nodes.size();
+
+    Vector<Vector<int>> adjacency;
+    Vector<int> disc, low, subtree, parent, nextNeighbor;
+    Vector<bool> isArticulation;
+    for (int i = 0; i < n; i++)
     {
-        if ((overloadedEdges[i].srcID == srcID && overloadedEdges[i].destID == destID) ||
-            (overloadedEdges[i].srcID == destID && overloadedEdges[i].destID == srcID))
+        Vector<int> open;
+        for (auto &edge : nodes[i].adjacencyList)
         {
-            return overloadedEdges[i].currentLoad >= overloadedEdges[i].maxCapacity;
+            int j = connectivityIndexOf(edge.destID);
+            if (j != -1 && j != i && !isEdgeBlocked(nodes[i].id, edge.destID))
+                open.push_back(j);
         }
+        adjacency.push_back(open);
+        disc.push_back(-1);
+        low.push_back(0);
+        subtree.push_back(0);
+        parent.push_back(-1);
+        nextNeighbor.push_back(0);
+        isArticulation.push_back(false);
     }
-    return false;
-}
 
-void CourierSystem::displayOverloadedRoutes()
-{
-    Table t;
-    t.addHeader("Source ID");
-    t.addHeader("Destination ID");
-    t.addHeader("Current Load");
-    t.addHeader("Max Capacity");
-    t.addHeader("Status");
+    articulationCities.clear();
+    bridgeEdges.clear();
+    bridgeCutOff.clear();
 
-    bool hasOverloaded = false;
-    for (int i = 0; i < overloadedEdges.size(); i++)
+    int timer = 0;
+    Vector<int> dfsStack;
+    for (int root = 0; root < n; root++)
     {
-        hasOverloaded = true;
-        City *src = cityMap.getNodeData(overloadedEdges[i].srcID);
-        City *dest = cityMap.getNodeData(overloadedEdges[i].destID);
-        string srcName = src ? src->name : to_string(overloadedEdges[i].srcID);
-        string destName = dest ? dest->name : to_string(overloadedEdges[i].destID);
-        string status = (overloadedEdges[i].currentLoad >= overloadedEdges[i].maxCapacity) ? "OVERLOADED" : "High Load";
+        if (disc[root] != -1)
+            continue;
 
-        t.addRow({srcName,
-                  destName,
-                  to_string(overloadedEdges[i].currentLoad),
-                  to_string(overloadedEdges[i].maxCapacity),
-                  status});
+        Vector<int> bridgeChildren;
+        int rootChildren = 0;
+        disc[root] = low[root] = timer++;
+        subtree[root] = 1;
+        dfsStack.push_back(root);
+
+        while (!dfsStack.empty())
+        {
+            int u = dfsStack[dfsStack.size() - 1];
+            if (nextNeighbor[u] < adjacency[u].size())
+            {
+                int v = adjacency[u][nextNeighbor[u]++];
+                if (disc[v] == -1)
+                {
+                    parent[v] = u;
+                    disc[v] = low[v] = timer++;
+                    subtree[v] = 1;
+                    dfsStack.push_back(v);
+                    if (u == root)
+                        rootChildren++;
+                }
+                else if (v != parent[u] && disc[v] < low[u])
+                {
+                    low[u] = disc[v];
+                }
+                continue;
+            }
+
+            dfsStack.pop_back();
+            int p = parent[u];
+            if (p == -1)
+                continue;
+
+            if (low[u] < low[p])
+                low[p] = low[u];
+            subtree[p] += subtree[u];
+            if (low[u] > disc[p])
+                bridgeChildren.push_back(u);
+            if (p != root && low[u] >= disc[p])
+                isArticulation[p] = true;
+        }
+
+        if (rootChildren > 1)
+            isArticulation[root] = true;
+
+        int componentSize = subtree[root];
+        for (int i = 0; i < bridgeChildren.size(); i++)
+        {
+            int child = bridgeChildren[i];
+            int cutOff = subtree[child];
+            if (componentSize - cutOff < cutOff)
+                cutOff = componentSize - cutOff;
+            bridgeEdges.push_back(edgeKey(nodes[parent[child]].id, nodes[child].id));
+            bridgeCutOff.push_back(cutOff);
+        }
     }
 
-    if (!hasOverloaded)
+    for (int i = 0; i < n; i++)
     {
-        cout << "\n[INFO] No overloaded routes.\n";
-        return;
+        if (isArticulation[i])
+            articulationCities.push_back(nodes[i].id);
     }
 
-    cout << "\n=== Overloaded Routes ===\n";
-    t.print();
+    vulnerabilityVersion = connectivityVersion;
 }
 
-Vector<Parcel> CourierSystem::getParcelsByWeightCategory(WeightCategory category)
+void CourierSystem::displayNetworkVulnerabilities()
 {
-    Vector<Parcel> result;
-    for (int i = 0; i < allParcels.size(); i++)
+    computeVulnerabilities();
+
+    cout << "\n=== Network Connectivity ===\n";
+    cout << "Connected regions under current closures: " << openComponents.components() << "\n";
+    cout << "Connected regions ignoring closures: " << roadComponents.components() << "\n";
+
+    if (bridgeEdges.empty())
     {
-        if (allParcels[i].getWeightCategory() == category)
+        cout << "\n[INFO] No single road closure would split the network.\n";
+    }
+    else
+    {
+        Table t;
+        t.addHeader("Source");
+        t.addHeader("Destination");
+        t.addHeader("Cities Cut Off");
+
+        for (int i = 0; i < bridgeEdges.size(); i++)
         {
-            result.push_back(allParcels[i]);
+            int srcID = static_cast<int>(bridgeEdges[i] >> 32);
+            int destID = static_cast<int>(bridgeEdges[i] & 0xFFFFFFFFLL);
+            City *src = cityMap.getNodeData(srcID);
+            City *dest = cityMap.getNodeData(destID);
+            t.addRow({src ? src->name : to_string(srcID),
+                      dest ? dest->name : to_string(destID),
+                      to_string(bridgeCutOff[i])});
         }
+
+        cout << "\n=== Critical Roads (closure splits the network) ===\n";
+        t.print();
     }
-    return result;
-}
 
-Vector<Parcel> CourierSystem::getParcelsByDestination(int destCityID)
-{
-    Vector<Parcel> result;
-    for (int i = 0; i < allParcels.size(); i++)
+    if (articulationCities.empty())
     {
-        if (allParcels[i].destCityID == destCityID)
-        {
-            result.push_back(allParcels[i]);
-        }
+        cout << "\n[INFO] No single city closure would split the network.\n";
+        return;
+    }
+
+    cout << "\n=== Critical Junctions ===\n";
+    for (int i = 0; i < articulationCities.size(); i++)
+    {
+        City *c = cityMap.getNodeData(articulationCities[i]);
+        cout << "  - " << (c ? c->name : to_string(articulationCities[i])) << " (ID: " << articulationCities[i] << ")\n";
     }
-    return result;
 }
 
-void CourierSystem::sortParcelsByWeight(Vector<Parcel> &parcels)
+void CourierSystem::buildRoadSnapshot(RoadSnapshot &snapshot, bool withDemand, bool avoidOverloaded)
 {
+    if (connectivityDirty)
+        rebuildConnectivity();
 
-    for (int i = 0; i < parcels.size(); i++)
+    Vector<Graph<City>::GraphNode> &nodes = cityMap.getNodes();
+    int n = nodes.size();
+    OverlayGraph::View roads = roadNetwork.acquire();
+    HashTable<long long, int> undirectedEdges;
+
+    for (int i = 0; i < n; i++)
     {
-        for (int j = 0; j < parcels.size() - i - 1; j++)
+        int cityID = nodes[i].id;
+        snapshot.cityIDs.push_back(cityID);
+        snapshot.offsets.push_back(snapshot.targets.size());
+        int u = roads.indexOf(cityID);
+        if (u == -1)
+            continue;
+
+        auto collect = [&](int v, int weight)
         {
-            if (parcels[j].weight > parcels[j + 1].weight)
+            int destID = roads.idAt(v);
+            int j = connectivityIndexOf(destID);
+            if (j == -1 || j == i || isEdgeBlocked(cityID, destID))
+                return;
+            if (avoidOverloaded && isPathOverloaded(cityID, destID))
+                return;
+
+            long long key = edgeKey(cityID, destID);
+            int *existing = undirectedEdges.get(key);
+            int edgeID;
+            if (existing)
             {
-                Parcel temp = parcels[j];
-                parcels[j] = parcels[j + 1];
-                parcels[j + 1] = temp;
+                edgeID = *existing;
             }
-        }
+            else
+            {
+                edgeID = snapshot.edgeSrc.size();
+                snapshot.edgeSrc.push_back(cityID);
+                snapshot.edgeDest.push_back(destID);
+                undirectedEdges.insert(key, edgeID);
+            }
+
+            snapshot.targets.push_back(j);
+            snapshot.weights.push_back(weight);
+            snapshot.edgeOf.push_back(edgeID);
+        };
+        roads.forEachNeighbor(u, collect);
     }
-}
+    snapshot.offsets.push_back(snapshot.targets.size());
 
-void CourierSystem::sortParcelsByDestination(Vector<Parcel> &parcels)
+    for (int i = 0; i <= n; i++)
+    {
+        snapshot.reverseOffsets.push_back(0);
+    }
+    for (int e = 0; e < snapshot.targets.size(); e++)
+    {
+        snapshot.reverseOffsets[snapshot.targets[e] + 1]++;
+    }
+    for (int i = 0; i < n; i++)
+    {
+        snapshot.reverseOffsets[i + 1] += snapshot.reverseOffsets[i];
+    }
+    Vector<int> fill;
+    for (int i = 0; i < n; i++)
+    {
+        fill.push_back(snapshot.reverseOffsets[i]);
+    }
+    for (int e = 0; e < snapshot.targets.size(); e++)
+    {
+        snapshot.reverseSources.push_back(0);
+        snapshot.reverseWeights.push_back(0);
+    }
+    for (int u = 0; u < n; u++)
+    {
+        for (int e = snapshot.offsets[u]; e < snapshot.offsets[u + 1]; e++)
+        {
+            int slot = fill[snapshot.targets[e]]++;
+            snapshot.reverseSources[slot] = u;
+            snapshot.reverseWeights[slot] = snapshot.weights[e];
+        }
+    }
+
+    if (!withDemand)
+        return;
+
+    HashTable<long long, int> pairParcels;
+    for (int i = 0; i < allParcels.size(); i++)
+    {
+        int src = connectivityIndexOf(allParcels[i].sourceCityID);
+        int dest = connectivityIndexOf(allParcels[i].destCityID);
+        if (src == -1 || dest == -1 || src == dest)
+            continue;
+
+        long long key = static_cast<long long>(src) * n + dest;
+        int *count = pairParcels.get(key);
+        if (count)
+            (*count)++;
+        else
+            pairParcels.insert(key, 1);
+    }
+
+    Vector<Vector<int>> targetsBySource, parcelsBySource;
+    for (int i = 0; i < n; i++)
+    {
+        targetsBySource.push_back(Vector<int>());
+        parcelsBySource.push_back(Vector<int>());
+    }
+
+    Vector<long long> pairs = pairParcels.getAllKeys();
+    for (int i = 0; i < pairs.size(); i++)
+    {
+        int src = static_cast<int>(pairs[i] / n);
+        targetsBySource[src].push_back(static_cast<int>(pairs[i] % n));
+        parcelsBySource[src].push_back(*pairParcels.get(pairs[i]));
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        snapshot.demandOffsets.push_back(snapshot.demandTargets.size());
+        for (int j = 0; j < targetsBySource[i].size(); j++)
+        {
+            snapshot.demandTargets.push_back(targetsBySource[i][j]);
+            snapshot.demandParcels.push_back(parcelsBySource[i][j]);
+        }
+    }
+    snapshot.demandOffsets.push_back(snapshot.demandTargets.size());
+}
+
+void CourierSystem::snapshotShortestPaths(const RoadSnapshot &snapshot, int source, int skipEdge, CriticalityWorkspace &ws)
+{
+    int n = snapshot.cityIDs.size();
+    for (int i = 0; i < n; i++)
+    {
+        ws.dist[i] = 2147483647;
+        ws.sigma[i] = 0;
+    }
+    ws.order.clear();
+
+    ws.dist[source] = 0;
+    ws.sigma[source] = 1;
+    MinHeap<DijkstraNode> pq;
+    pq.push({source, 0});
+
+    while (!pq.empty())
+    {
+        DijkstraNode current = pq.top();
+        pq.pop();
+
+        int u = current.id;
+        if (current.dist > ws.dist[u])
+            continue;
+        ws.order.push_back(u);
+
+        for (int e = snapshot.offsets[u]; e < snapshot.offsets[u + 1]; e++)
+        {
+            if (snapshot.edgeOf[e] == skipEdge)
+                continue;
+
+            int v = snapshot.targets[e];
+            int newDist = ws.dist[u] + snapshot.weights[e];
+            if (newDist < ws.dist[v])
+            {
+                ws.dist[v] = newDist;
+                ws.sigma[v] = ws.sigma[u];
+                pq.push({v, newDist});
+            }
+            else if (newDist == ws.dist[v])
+            {
+                ws.sigma[v] += ws.sigma[u];
+            }
+        }
+    }
+}
+
+void CourierSystem::analyzeRoadCriticality(int topN)
+{
+    RoadSnapshot snapshot;
+    buildRoadSnapshot(snapshot);
+
+    int n = snapshot.cityIDs.size();
+    int edgeCount = snapshot.edgeSrc.size();
+    if (edgeCount == 0)
+    {
+        cout << "\n[INFO] No open roads to analyze.\n";
+        return;
+    }
+
+    if (snapshot.demandTargets.empty())
+    {
+        cout << "\n[INFO] No parcel demand recorded. Weighting all city pairs equally.\n";
+        snapshot.demandOffsets.clear();
+        for (int i = 0; i < n; i++)
+        {
+            snapshot.demandOffsets.push_back(snapshot.demandTargets.size());
+            for (int j = 0; j < n; j++)
+            {
+                if (j == i)
+                    continue;
+                snapshot.demandTargets.push_back(j);
+                snapshot.demandParcels.push_back(1);
+            }
+        }
+        snapshot.demandOffsets.push_back(snapshot.demandTargets.size());
+    }
+
+    Vector<int> sources;
+    for (int i = 0; i < n; i++)
+    {
+        if (snapshot.demandOffsets[i + 1] > snapshot.demandOffsets[i])
+            sources.push_back(i);
+    }
+
+    int threadCount = static_cast<int>(thread::hardware_concurrency());
+    if (threadCount < 1)
+        threadCount = 1;
+    if (threadCount > sources.size())
+        threadCount = sources.size();
+
+    Vector<CriticalityWorkspace> workspaces;
+    for (int t = 0; t < threadCount; t++)
+    {
+        CriticalityWorkspace ws;
+        for (int i = 0; i < n; i++)
+        {
+            ws.dist.push_back(0);
+            ws.sigma.push_back(0);
+            ws.dependency.push_back(0);
+        }
+        for (int e = 0; e < edgeCount; e++)
+        {
+            ws.edgeScore.push_back(0);
+        }
+        workspaces.push_back(ws);
+    }
+
+    Vector<int> baseline;
+    for (int i = 0; i < snapshot.demandTargets.size(); i++)
+    {
+        baseline.push_back(0);
+    }
+    Vector<int> sourceDist;
+    for (int i = 0; i < sources.size() * n; i++)
+    {
+        sourceDist.push_back(0);
+    }
+
+    atomic<int> nextSource(0);
+    auto betweennessWorker = [&](int t)
+    {
+        CriticalityWorkspace &ws = workspaces[t];
+        for (int slot = nextSource++; slot < sources.size(); slot = nextSource++)
+        {
+            int s = sources[slot];
+            snapshotShortestPaths(snapshot, s, -1, ws);
+
+            for (int i = 0; i < n; i++)
+            {
+                ws.dependency[i] = 0;
+                sourceDist[slot * n + i] = ws.dist[i];
+            }
+            for (int d = snapshot.demandOffsets[s]; d < snapshot.demandOffsets[s + 1]; d++)
+            {
+                ws.dependency[snapshot.demandTargets[d]] += snapshot.demandParcels[d];
+                baseline[d] = ws.dist[snapshot.demandTargets[d]];
+            }
+
+            for (int k = ws.order.size() - 1; k > 0; k--)
+            {
+                int w = ws.order[k];
+                if (ws.dependency[w] == 0)
+                    continue;
+
+                for (int e = snapshot.offsets[w]; e < snapshot.offsets[w + 1]; e++)
+                {
+                    int v = snapshot.targets[e];
+                    if (ws.dist[v] == 2147483647 || ws.dist[v] + snapshot.weights[e] != ws.dist[w])
+                        continue;
+
+                    double share = ws.sigma[v] / ws.sigma[w] * ws.dependency[w];
+                    ws.edgeScore[snapshot.edgeOf[e]] += share;
+                    ws.dependency[v] += share;
+                }
+            }
+        }
+    };
+
+    Vector<thread *> workers;
+    for (int t = 0; t < threadCount; t++)
+    {
+        workers.push_back(new thread(betweennessWorker, t));
+    }
+    for (int t = 0; t < workers.size(); t++)
+    {
+        workers[t]->join();
+        delete workers[t];
+    }
+    workers.clear();
+
+    Vector<double> score;
+    Vector<int> candidates;
+    for (int e = 0; e < edgeCount; e++)
+    {
+        double total = 0;
+        for (int t = 0; t < threadCount; t++)
+        {
+            total += workspaces[t].edgeScore[e];
+        }
+        score.push_back(total);
+        if (total > 0)
+            candidates.push_back(e);
+    }
+
+    Vector<long long> extraKm;
+    Vector<int> cutOffParcels;
+    for (int e = 0; e < edgeCount; e++)
+    {
+        extraKm.push_back(0);
+        cutOffParcels.push_back(0);
+    }
+
+    atomic<int> nextCandidate(0);
+    auto whatIfWorker = [&](int t)
+    {
+        CriticalityWorkspace &ws = workspaces[t];
+        for (int c = nextCandidate++; c < candidates.size(); c = nextCandidate++)
+        {
+            int e = candidates[c];
+            int a = connectivityIndexOf(snapshot.edgeSrc[e]);
+            int b = connectivityIndexOf(snapshot.edgeDest[e]);
+
+            for (int slot = 0; slot < sources.size(); slot++)
+            {
+                int da = sourceDist[slot * n + a];
+                int db = sourceDist[slot * n + b];
+                if (da == 2147483647 || db == 2147483647)
+                    continue;
+
+                int gap = da > db ? da - db : db - da;
+                bool tight = false;
+                for (int k = snapshot.offsets[a]; k < snapshot.offsets[a + 1]; k++)
+                {
+                    if (snapshot.edgeOf[k] == e && snapshot.weights[k] == gap)
+                        tight = true;
+                }
+                if (!tight)
+                    continue;
+
+                int s = sources[slot];
+                snapshotShortestPaths(snapshot, s, e, ws);
+                for (int d = snapshot.demandOffsets[s]; d < snapshot.demandOffsets[s + 1]; d++)
+                {
+                    if (baseline[d] == 2147483647)
+                        continue;
+
+                    int after = ws.dist[snapshot.demandTargets[d]];
+                    if (after == 2147483647)
+                        cutOffParcels[e] += snapshot.demandParcels[d];
+                    else
+                        extraKm[e] += static_cast<long long>(after - baseline[d]) * snapshot.demandParcels[d];
+                }
+            }
+        }
+    };
+
+    int whatIfThreads = threadCount < candidates.size() ? threadCount : candidates.size();
+    for (int t = 0; t < whatIfThreads; t++)
+    {
+        workers.push_back(new thread(whatIfWorker, t));
+    }
+    for (int t = 0; t < workers.size(); t++)
+    {
+        workers[t]->join();
+        delete workers[t];
+    }
+
+    auto moreCritical = [&](int x, int y) -> bool
+    {
+        if (cutOffParcels[x] != cutOffParcels[y])
+            return cutOffParcels[x] > cutOffParcels[y];
+        if (extraKm[x] != extraKm[y])
+            return extraKm[x] > extraKm[y];
+        if (score[x] != score[y])
+            return score[x] > score[y];
+        return x < y;
+    };
+    sort(candidates.begin(), candidates.end(), moreCritical);
+
+    if (candidates.empty())
+    {
+        cout << "\n[INFO] No demanded route uses the open road network.\n";
+        return;
+    }
+
+    Table t;
+    t.addHeader("Source");
+    t.addHeader("Destination");
+    t.addHeader("Parcels Through");
+    t.addHeader("Extra km if Closed");
+    t.addHeader("Parcels Cut Off");
+
+    int shown = topN < candidates.size() ? topN : candidates.size();
+    for (int i = 0; i < shown; i++)
+    {
+        int e = candidates[i];
+        City *src = cityMap.getNodeData(snapshot.edgeSrc[e]);
+        City *dest = cityMap.getNodeData(snapshot.edgeDest[e]);
+        ostringstream through;
+        through << fixed << setprecision(1) << score[e];
+        t.addRow({src ? src->name : to_string(snapshot.edgeSrc[e]),
+                  dest ? dest->name : to_string(snapshot.edgeDest[e]),
+                  through.str(),
+                  to_string(extraKm[e]),
+                  to_string(cutOffParcels[e])});
+    }
+
+    cout << "\n=== Road Criticality (What-If Closures) ===\n";
+    t.print();
+    cout << "\n[INFO] Evaluated " << candidates.size() << " of " << edgeCount << " open roads on "
+         << threadCount << " thread(s). Live closures were not modified.\n";
+}
+
+void CourierSystem::boundedSearch(const RoadSnapshot &snapshot, int source, int radius, Vector<int> &dist, Vector<ReachableCity> &area)
+{
+    Vector<int> touched;
+    MinHeap<DijkstraNode> pq;
+    dist[source] = 0;
+    touched.push_back(source);
+    pq.push({source, 0});
+
+    while (!pq.empty())
+    {
+        DijkstraNode current = pq.top();
+        pq.pop();
+
+        int u = current.id;
+        if (current.dist > dist[u])
+            continue;
+        area.push_back(ReachableCity(snapshot.cityIDs[u], current.dist));
+
+        for (int e = snapshot.offsets[u]; e < snapshot.offsets[u + 1]; e++)
+        {
+            int v = snapshot.targets[e];
+            int newDist = current.dist + snapshot.weights[e];
+            if (newDist > radius || newDist >= dist[v])
+                continue;
+
+            if (dist[v] == 2147483647)
+                touched.push_back(v);
+            dist[v] = newDist;
+            pq.push({v, newDist});
+        }
+    }
+
+    for (int i = 0; i < touched.size(); i++)
+    {
+        dist[touched[i]] = 2147483647;
+    }
+}
+
+void CourierSystem::syncServiceAreaCache()
+{
+    if (connectivityDirty)
+        rebuildConnectivity();
+    if (serviceAreaVersion == connectivityVersion)
+        return;
+
+    serviceAreaCache.clear();
+    serviceSnapshot = RoadSnapshot();
+    buildRoadSnapshot(serviceSnapshot, false);
+    serviceAreaVersion = connectivityVersion;
+}
+
+void CourierSystem::syncRoutingSnapshot()
+{
+    if (connectivityDirty)
+        rebuildConnectivity();
+    if (routingVersion == connectivityVersion && routingOverloadVersion == overloadVersion)
+        return;
+
+    hubTrees.clear();
+    routingSnapshot = RoadSnapshot();
+    buildRoadSnapshot(routingSnapshot, false, true);
+    routingVersion = connectivityVersion;
+    routingOverloadVersion = overloadVersion;
+}
+
+void CourierSystem::addHub(int cityID)
+{
+    if (!validateCityID(cityID))
+    {
+        cout << "\n[ERROR] Invalid city ID.\n";
+        return;
+    }
+
+    for (int i = 0; i < hubCities.size(); i++)
+    {
+        if (hubCities[i] == cityID)
+        {
+            cout << "\n[INFO] City " << cityID << " is already a hub.\n";
+            return;
+        }
+    }
+
+    hubCities.push_back(cityID);
+    CSVUtils::saveHub("hubs.csv", cityID);
+    City *city = cityMap.getNodeData(cityID);
+    if (city && city->hasLocation)
+    {
+        double point[3];
+        toUnitVector(city->latitude, city->longitude, point);
+        hubLocator.insert(cityID, point);
+    }
+    cout << "\n[SUCCESS] " << (city ? city->name : to_string(cityID)) << " registered as a hub.\n";
+}
+
+const Vector<int> &CourierSystem::getHubs() const
+{
+    return hubCities;
+}
+
+bool CourierSystem::getServiceArea(int hubID, int radiusKm, Vector<ReachableCity> &area)
+{
+    area.clear();
+    if (radiusKm < 0 || !validateCityID(hubID))
+        return false;
+
+    syncServiceAreaCache();
+    long long key = (static_cast<long long>(hubID) << 32) | static_cast<unsigned int>(radiusKm);
+    Vector<ReachableCity> *cached = serviceAreaCache.get(key);
+    if (cached)
+    {
+        area = *cached;
+        return true;
+    }
+
+    int source = connectivityIndexOf(hubID);
+    if (source == -1)
+        return false;
+
+    Vector<int> dist;
+    for (int i = 0; i < serviceSnapshot.cityIDs.size(); i++)
+    {
+        dist.push_back(2147483647);
+    }
+    boundedSearch(serviceSnapshot, source, radiusKm, dist, area);
+    serviceAreaCache.insert(key, area);
+    return true;
+}
+
+void CourierSystem::computeAllServiceAreas(int radiusKm)
+{
+    if (radiusKm < 0)
+        return;
+
+    syncServiceAreaCache();
+
+    Vector<int> pending;
+    for (int i = 0; i < hubCities.size(); i++)
+    {
+        long long key = (static_cast<long long>(hubCities[i]) << 32) | static_cast<unsigned int>(radiusKm);
+        if (connectivityIndexOf(hubCities[i]) != -1 && !serviceAreaCache.contains(key))
+            pending.push_back(hubCities[i]);
+    }
+    if (pending.empty())
+        return;
+
+    Vector<Vector<ReachableCity>> results;
+    for (int i = 0; i < pending.size(); i++)
+    {
+        results.push_back(Vector<ReachableCity>());
+    }
+
+    int threadCount = static_cast<int>(thread::hardware_concurrency());
+    if (threadCount < 1)
+        threadCount = 1;
+    if (threadCount > pending.size())
+        threadCount = pending.size();
+
+    atomic<int> nextHub(0);
+    auto worker = [&]()
+    {
+        Vector<int> dist;
+        for (int i = 0; i < serviceSnapshot.cityIDs.size(); i++)
+        {
+            dist.push_back(2147483647);
+        }
+        for (int h = nextHub++; h < pending.size(); h = nextHub++)
+        {
+            boundedSearch(serviceSnapshot, connectivityIndexOf(pending[h]), radiusKm, dist, results[h]);
+        }
+    };
+
+    Vector<thread *> workers;
+    for (int t = 0; t < threadCount; t++)
+    {
+        workers.push_back(new thread(worker));
+    }
+    for (int t = 0; t < workers.size(); t++)
+    {
+        workers[t]->join();
+        delete workers[t];
+    }
+
+    for (int h = 0; h < pending.size(); h++)
+    {
+        long long key = (static_cast<long long>(pending[h]) << 32) | static_cast<unsigned int>(radiusKm);
+        serviceAreaCache.insert(key, results[h]);
+    }
+}
+
+void CourierSystem::displayServiceArea(int hubID, int radiusKm)
+{
+    if (radiusKm <= 0)
+    {
+        cout << "\n[ERROR] Radius must be greater than 0.\n";
+        return;
+    }
+
+    Vector<ReachableCity> area;
+    if (!getServiceArea(hubID, radiusKm, area))
+    {
+        cout << "\n[ERROR] Invalid city ID.\n";
+        return;
+    }
+
+    City *hub = cityMap.getNodeData(hubID);
+    string hubName = hub ? hub->name : to_string(hubID);
+    if (area.size() <= 1)
+    {
+        cout << "\n[INFO] No other city is reachable from " << hubName << " within " << radiusKm << " km.\n";
+        return;
+    }
+
+    Table t;
+    t.addHeader("City ID");
+    t.addHeader("City");
+    t.addHeader("Distance (km)");
+    for (int i = 1; i < area.size(); i++)
+    {
+        City *c = cityMap.getNodeData(area[i].cityID);
+        t.addRow({to_string(area[i].cityID), c ? c->name : to_string(area[i].cityID), to_string(area[i].distance)});
+    }
+
+    cout << "\n=== Service Area: " << hubName << " (" << radiusKm << " km, current closures) ===\n";
+    t.print();
+    cout << "\n[INFO] " << (area.size() - 1) << " cities reachable.\n";
+}
+
+void CourierSystem::displayHubServiceAreas(int radiusKm)
+{
+    if (radiusKm <= 0)
+    {
+        cout << "\n[ERROR] Radius must be greater than 0.\n";
+        return;
+    }
+
+    if (hubCities.empty())
+    {
+        cout << "\n[INFO] No hubs registered.\n";
+        return;
+    }
+
+    computeAllServiceAreas(radiusKm);
+
+    Table t;
+    t.addHeader("Hub");
+    t.addHeader("Cities Reached");
+    t.addHeader("Farthest City");
+    t.addHeader("Distance (km)");
+
+    for (int i = 0; i < hubCities.size(); i++)
+    {
+        Vector<ReachableCity> area;
+        if (!getServiceArea(hubCities[i], radiusKm, area))
+            continue;
+
+        City *hub = cityMap.getNodeData(hubCities[i]);
+        string farthest = "-";
+        string farthestDist = "-";
+        if (area.size() > 1)
+        {
+            ReachableCity &last = area[area.size() - 1];
+            City *c = cityMap.getNodeData(last.cityID);
+            farthest = c ? c->name : to_string(last.cityID);
+            farthestDist = to_string(last.distance);
+        }
+        t.addRow({hub ? hub->name : to_string(hubCities[i]), to_string(area.size() - 1), farthest, farthestDist});
+    }
+
+    cout << "\n=== Hub Service Areas (" << radiusKm << " km) ===\n";
+    t.print();
+}
+
+void CourierSystem::snapshotTree(const RoadSnapshot &snapshot, int root, bool reverse, Vector<int> &dist, Vector<int> &link)
+{
+    const Vector<int> &offsets = reverse ? snapshot.reverseOffsets : snapshot.offsets;
+    const Vector<int> &ends = reverse ? snapshot.reverseSources : snapshot.targets;
+    const Vector<int> &weights = reverse ? snapshot.reverseWeights : snapshot.weights;
+
+    int n = snapshot.cityIDs.size();
+    dist.clear();
+    link.clear();
+    for (int i = 0; i < n; i++)
+    {
+        dist.push_back(2147483647);
+        link.push_back(-1);
+    }
+
+    dist[root] = 0;
+    MinHeap<DijkstraNode> pq;
+    pq.push({root, 0});
+
+    while (!pq.empty())
+    {
+        DijkstraNode current = pq.top();
+        pq.pop();
+
+        int u = current.id;
+        if (current.dist > dist[u])
+            continue;
+
+        for (int e = offsets[u]; e < offsets[u + 1]; e++)
+        {
+            int v = ends[e];
+            int newDist = current.dist + weights[e];
+            if (newDist < dist[v])
+            {
+                dist[v] = newDist;
+                link[v] = u;
+                pq.push({v, newDist});
+            }
+        }
+    }
+}
+
+const CourierSystem::HubTree *CourierSystem::getHubTree(int hubID)
+{
+    syncRoutingSnapshot();
+
+    HubTree *cached = hubTrees.get(hubID);
+    if (cached)
+        return cached;
+
+    int root = connectivityIndexOf(hubID);
+    if (root == -1)
+        return nullptr;
+
+    HubTree tree;
+    snapshotTree(routingSnapshot, root, false, tree.forwardDist, tree.forwardParent);
+    snapshotTree(routingSnapshot, root, true, tree.reverseDist, tree.reverseNext);
+    hubTrees.insert(hubID, tree);
+    return hubTrees.get(hubID);
+}
+
+int CourierSystem::calculateViaHubPath(int srcID, int destID, const Vector<int> &candidateHubs, Vector<int> &path, int &chosenHub)
+{
+    path.clear();
+    chosenHub = -1;
+
+    syncRoutingSnapshot();
+    const Vector<int> &hubs = candidateHubs.empty() ? hubCities : candidateHubs;
+    int src = connectivityIndexOf(srcID);
+    int dest = connectivityIndexOf(destID);
+    if (src == -1 || dest == -1 || hubs.empty())
+        return -1;
+
+    for (int i = 0; i < hubs.size(); i++)
+    {
+        getHubTree(hubs[i]);
+    }
+
+    long long best = 2147483647;
+    const HubTree *bestTree = nullptr;
+    for (int i = 0; i < hubs.size(); i++)
+    {
+        const HubTree *tree = hubTrees.get(hubs[i]);
+        if (!tree || tree->reverseDist[src] == 2147483647 || tree->forwardDist[dest] == 2147483647)
+            continue;
+
+        long long total = static_cast<long long>(tree->reverseDist[src]) + tree->forwardDist[dest];
+        if (total < best)
+        {
+            best = total;
+            bestTree = tree;
+            chosenHub = hubs[i];
+        }
+    }
+
+    if (!bestTree)
+        return -1;
+
+    for (int curr = src; curr != -1; curr = bestTree->reverseNext[curr])
+    {
+        path.push_back(routingSnapshot.cityIDs[curr]);
+    }
+
+    Vector<int> tail;
+    for (int curr = dest; curr != -1; curr = bestTree->forwardParent[curr])
+    {
+        tail.push_back(routingSnapshot.cityIDs[curr]);
+    }
+    for (int i = tail.size() - 2; i >= 0; i--)
+    {
+        path.push_back(tail[i]);
+    }
+
+    return static_cast<int>(best);
+}
+
+void CourierSystem::displayViaHubRoute(int srcID, int destID, int hubID)
+{
+    if (!validateCityID(srcID) || !validateCityID(destID))
+    {
+        cout << "\n[ERROR] Invalid city IDs.\n";
+        return;
+    }
+
+    Vector<int> candidates;
+    if (hubID != -1)
+    {
+        if (!validateCityID(hubID))
+        {
+            cout << "\n[ERROR] Invalid hub city ID.\n";
+            return;
+        }
+        candidates.push_back(hubID);
+    }
+    else if (hubCities.empty())
+    {
+        cout << "\n[INFO] No hubs registered.\n";
+        return;
+    }
+
+    Vector<int> path;
+    int chosenHub;
+    int distance = calculateViaHubPath(srcID, destID, candidates, path, chosenHub);
+    if (distance == -1)
+    {
+        cout << "\n[ERROR] No open route passes through " << (hubID != -1 ? "this hub" : "any registered hub") << ".\n";
+        return;
+    }
+
+    Vector<int> direct;
+    int directDistance = calculateShortestPath(srcID, destID, direct, true);
+
+    City *hub = cityMap.getNodeData(chosenHub);
+    cout << "\n=== Route via Hub ===\n";
+    cout << "Hub: " << (hub ? hub->name : to_string(chosenHub)) << "\n";
+    cout << "Total Distance: " << distance << " km";
+    if (directDistance != -1)
+        cout << " (+" << (distance - directDistance) << " km over direct route)";
+    cout << "\nPath: ";
+    for (int i = 0; i < path.size(); i++)
+    {
+        City *c = cityMap.getNodeData(path[i]);
+        cout << (c ? c->name : to_string(path[i]));
+        if (path[i] == chosenHub)
+            cout << " [HUB]";
+        if (i < path.size() - 1)
+            cout << " -> ";
+    }
+    cout << "\n";
+}
+
+void CourierSystem::buildPartitionLevel(int n, Vector<PartitionEdge> &edges, PartitionLevel &level)
+{
+    sort(edges.begin(), edges.end(), [](const PartitionEdge &a, const PartitionEdge &b)
+         { return a.u != b.u ? a.u < b.u : a.v < b.v; });
+
+    level.offsets = Vector<int>(n + 1, 0);
+    level.targets.clear();
+    level.edgeWeights.clear();
+    for (int i = 0; i < edges.size(); i++)
+    {
+        int last = level.targets.size() - 1;
+        if (last >= 0 && level.targets[last] == edges[i].v && i > 0 && edges[i - 1].u == edges[i].u)
+        {
+            level.edgeWeights[last] += edges[i].weight;
+            continue;
+        }
+        level.targets.push_back(edges[i].v);
+        level.edgeWeights.push_back(edges[i].weight);
+        level.offsets[edges[i].u + 1] = level.targets.size();
+    }
+    for (int i = 0; i < n; i++)
+    {
+        if (level.offsets[i + 1] < level.offsets[i])
+            level.offsets[i + 1] = level.offsets[i];
+    }
+}
+
+void CourierSystem::coarsenLevel(PartitionLevel &fine, int maxVertexWeight, PartitionLevel &coarse)
+{
+    int n = fine.vertexWeight.size();
+    fine.coarseOf = Vector<int>(n, -1);
+    coarse.vertexWeight.clear();
+
+    for (int u = 0; u < n; u++)
+    {
+        if (fine.coarseOf[u] != -1)
+            continue;
+
+        int best = -1;
+        for (int e = fine.offsets[u]; e < fine.offsets[u + 1]; e++)
+        {
+            int v = fine.targets[e];
+            if (fine.coarseOf[v] != -1 || fine.vertexWeight[u] + fine.vertexWeight[v] > maxVertexWeight)
+                continue;
+            if (best == -1 || fine.edgeWeights[e] > fine.edgeWeights[best] ||
+                (fine.edgeWeights[e] == fine.edgeWeights[best] && fine.vertexWeight[v] < fine.vertexWeight[fine.targets[best]]))
+                best = e;
+        }
+
+        int id = coarse.vertexWeight.size();
+        fine.coarseOf[u] = id;
+        int weight = fine.vertexWeight[u];
+        if (best != -1)
+        {
+            fine.coarseOf[fine.targets[best]] = id;
+            weight += fine.vertexWeight[fine.targets[best]];
+        }
+        coarse.vertexWeight.push_back(weight);
+    }
+
+    Vector<PartitionEdge> edges;
+    for (int u = 0; u < n; u++)
+    {
+        for (int e = fine.offsets[u]; e < fine.offsets[u + 1]; e++)
+        {
+            int cu = fine.coarseOf[u], cv = fine.coarseOf[fine.targets[e]];
+            if (cu != cv)
+                edges.push_back({cu, cv, fine.edgeWeights[e]});
+        }
+    }
+    buildPartitionLevel(coarse.vertexWeight.size(), edges, coarse);
+}
+
+void CourierSystem::growInitialRegions(const PartitionLevel &level, int parts, Vector<int> &regionOf)
+{
+    int n = level.vertexWeight.size();
+    long long total = 0;
+    for (int i = 0; i < n; i++)
+    {
+        total += level.vertexWeight[i];
+    }
+
+    regionOf = Vector<int>(n, -1);
+    Vector<int> hops(n, -1);
+    Vector<int> gain(n, 0);
+    Vector<int> queue;
+    long long assigned = 0;
+
+    for (int p = 0; p < parts; p++)
+    {
+        if (p == parts - 1)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                if (regionOf[i] == -1)
+                    regionOf[i] = p;
+            }
+            break;
+        }
+
+        queue.clear();
+        for (int i = 0; i < n; i++)
+        {
+            hops[i] = -1;
+            if (regionOf[i] != -1 || (assigned == 0 && i == 0))
+            {
+                hops[i] = 0;
+                queue.push_back(i);
+            }
+        }
+        for (int head = 0; head < queue.size(); head++)
+        {
+            int u = queue[head];
+            for (int e = level.offsets[u]; e < level.offsets[u + 1]; e++)
+            {
+                int v = level.targets[e];
+                if (hops[v] == -1)
+                {
+                    hops[v] = hops[u] + 1;
+                    queue.push_back(v);
+                }
+            }
+        }
+
+        int seed = -1;
+        for (int i = 0; i < n; i++)
+        {
+            if (regionOf[i] != -1)
+                continue;
+            if (seed == -1 || hops[i] == -1 || (hops[seed] != -1 && hops[i] > hops[seed]))
+                seed = i;
+            if (hops[seed] == -1)
+                break;
+        }
+        if (seed == -1)
+            break;
+
+        long long target = (total - assigned) / (parts - p);
+        long long weight = 0;
+        Vector<int> candidates;
+        candidates.push_back(seed);
+        gain[seed] = 1;
+        int nextSeed = 0;
+        while (weight < target)
+        {
+            if (candidates.empty())
+            {
+                while (nextSeed < n && regionOf[nextSeed] != -1)
+                    nextSeed++;
+                if (nextSeed == n)
+                    break;
+                candidates.push_back(nextSeed);
+                gain[nextSeed] = 1;
+            }
+
+            int pick = 0;
+            for (int c = 1; c < candidates.size(); c++)
+            {
+                if (gain[candidates[c]] > gain[candidates[pick]])
+                    pick = c;
+            }
+            int u = candidates[pick];
+            candidates[pick] = candidates[candidates.size() - 1];
+            candidates.pop_back();
+            if (regionOf[u] != -1)
+                continue;
+
+            regionOf[u] = p;
+            weight += level.vertexWeight[u];
+            for (int e = level.offsets[u]; e < level.offsets[u + 1]; e++)
+            {
+                int v = level.targets[e];
+                if (regionOf[v] != -1)
+                    continue;
+                if (gain[v] == 0)
+                    candidates.push_back(v);
+                gain[v] += level.edgeWeights[e];
+            }
+        }
+        for (int c = 0; c < candidates.size(); c++)
+        {
+            gain[candidates[c]] = 0;
+        }
+        assigned += weight;
+    }
+}
+
+void CourierSystem::refineRegions(const PartitionLevel &level, int parts, Vector<int> &regionOf)
+{
+    int n = level.vertexWeight.size();
+    long long total = 0;
+    int heaviest = 0;
+    Vector<long long> regionWeight(parts, 0);
+    Vector<int> regionSize(parts, 0);
+    for (int i = 0; i < n; i++)
+    {
+        total += level.vertexWeight[i];
+        if (level.vertexWeight[i] > heaviest)
+            heaviest = level.vertexWeight[i];
+        regionWeight[regionOf[i]] += level.vertexWeight[i];
+        regionSize[regionOf[i]]++;
+    }
+    long long slack = total / (parts * 20);
+    long long limit = (total + parts - 1) / parts + (slack > heaviest ? slack : heaviest);
+
+    Vector<int> connection(parts, 0);
+    Vector<int> touched;
+    for (int pass = 0; pass < 8; pass++)
+    {
+        int moved = 0;
+        for (int u = 0; u < n; u++)
+        {
+            int own = regionOf[u];
+            if (regionSize[own] == 1)
+                continue;
+
+            touched.clear();
+            touched.push_back(own);
+            connection[own] = 0;
+            for (int e = level.offsets[u]; e < level.offsets[u + 1]; e++)
+            {
+                int q = regionOf[level.targets[e]];
+                if (connection[q] == 0 && q != own)
+                    touched.push_back(q);
+                connection[q] += level.edgeWeights[e];
+            }
+
+            int w = level.vertexWeight[u];
+            int best = -1;
+            int bestGain = 0;
+            for (int i = 1; i < touched.size(); i++)
+            {
+                int q = touched[i];
+                int gain = connection[q] - connection[own];
+                bool fits = regionWeight[q] + w <= limit;
+                bool balances = regionWeight[q] + w < regionWeight[own];
+                bool acceptable = (fits && (gain > 0 || (gain == 0 && balances))) ||
+                                  (regionWeight[own] > limit && fits && balances);
+                if (!acceptable)
+                    continue;
+                if (best == -1 || gain > bestGain || (gain == bestGain && regionWeight[q] < regionWeight[best]))
+                {
+                    best = q;
+                    bestGain = gain;
+                }
+            }
+            for (int i = 0; i < touched.size(); i++)
+            {
+                connection[touched[i]] = 0;
+            }
+
+            if (best != -1)
+            {
+                regionOf[u] = best;
+                regionWeight[own] -= w;
+                regionWeight[best] += w;
+                regionSize[own]--;
+                regionSize[best]++;
+                moved++;
+            }
+        }
+        if (moved == 0)
+            break;
+    }
+}
+
+void CourierSystem::regionSearch(const RoadSnapshot &snapshot, const Vector<int> &regionOf, int source, bool reverse,
+                                 Vector<int> &dist, Vector<int> &link, Vector<int> &touched)
+{
+    const Vector<int> &offsets = reverse ? snapshot.reverseOffsets : snapshot.offsets;
+    const Vector<int> &targets = reverse ? snapshot.reverseSources : snapshot.targets;
+    const Vector<int> &weights = reverse ? snapshot.reverseWeights : snapshot.weights;
+    int region = regionOf[source];
+
+    MinHeap<DijkstraNode> pq;
+    dist[source] = 0;
+    link[source] = -1;
+    touched.push_back(source);
+    pq.push({source, 0});
+
+    while (!pq.empty())
+    {
+        DijkstraNode current = pq.top();
+        pq.pop();
+
+        int u = current.id;
+        if (current.dist > dist[u])
+            continue;
+
+        for (int e = offsets[u]; e < offsets[u + 1]; e++)
+        {
+            int v = targets[e];
+            if (regionOf[v] != region)
+                continue;
+
+            int newDist = current.dist + weights[e];
+            if (newDist >= dist[v])
+                continue;
+
+            if (dist[v] == 2147483647)
+                touched.push_back(v);
+            dist[v] = newDist;
+            link[v] = u;
+            pq.push({v, newDist});
+        }
+    }
+}
+
+bool CourierSystem::partitionRegions(int parts)
+{
+    syncServiceAreaCache();
+    const RoadSnapshot &roads = serviceSnapshot;
+    int n = roads.cityIDs.size();
+    if (parts < 2 || parts > n)
+        return false;
+
+    Vector<int> parcelsAt(n, 0);
+    for (int i = 0; i < allParcels.size(); i++)
+    {
+        if (allParcels[i].status == Status::Delivered || allParcels[i].status == Status::Returned)
+            continue;
+        int city = connectivityIndexOf(allParcels[i].currentCityID);
+        if (city != -1)
+            parcelsAt[city]++;
+    }
+
+    Vector<PartitionLevel> levels;
+    levels.push_back(PartitionLevel());
+    Vector<PartitionEdge> edges;
+    for (int u = 0; u < n; u++)
+    {
+        levels[0].vertexWeight.push_back(1 + parcelsAt[u]);
+        for (int e = roads.offsets[u]; e < roads.offsets[u + 1]; e++)
+        {
+            edges.push_back({u, roads.targets[e], 1});
+            edges.push_back({roads.targets[e], u, 1});
+        }
+    }
+    buildPartitionLevel(n, edges, levels[0]);
+
+    long long total = n;
+    for (int i = 0; i < n; i++)
+    {
+        total += parcelsAt[i];
+    }
+    int maxVertexWeight = static_cast<int>(total / (parts * 4)) + 1;
+    int stopAt = parts * 8 > 32 ? parts * 8 : 32;
+    while (levels[levels.size() - 1].vertexWeight.size() > stopAt)
+    {
+        PartitionLevel coarse;
+        coarsenLevel(levels[levels.size() - 1], maxVertexWeight, coarse);
+        if (coarse.vertexWeight.size() * 10 > levels[levels.size() - 1].vertexWeight.size() * 9)
+            break;
+        levels.push_back(coarse);
+    }
+
+    Vector<int> regionOf;
+    growInitialRegions(levels[levels.size() - 1], parts, regionOf);
+    refineRegions(levels[levels.size() - 1], parts, regionOf);
+    for (int l = levels.size() - 2; l >= 0; l--)
+    {
+        Vector<int> finer(levels[l].vertexWeight.size(), 0);
+        for (int v = 0; v < finer.size(); v++)
+        {
+            finer[v] = regionOf[levels[l].coarseOf[v]];
+        }
+        regionOf = finer;
+        refineRegions(levels[l], parts, regionOf);
+    }
+
+    regions.parts = parts;
+    regions.regionOf = regionOf;
+    regions.cityCount = Vector<int>(parts, 0);
+    regions.parcelCount = Vector<int>(parts, 0);
+    regions.cutRoads = 0;
+    regions.totalRoads = 0;
+    for (int u = 0; u < n; u++)
+    {
+        regions.cityCount[regionOf[u]]++;
+        regions.parcelCount[regionOf[u]] += parcelsAt[u];
+        for (int e = levels[0].offsets[u]; e < levels[0].offsets[u + 1]; e++)
+        {
+            int v = levels[0].targets[e];
+            if (v < u)
+                continue;
+            regions.totalRoads++;
+            if (regionOf[v] != regionOf[u])
+                regions.cutRoads++;
+        }
+    }
+
+    buildRegionTables();
+    return true;
+}
+
+void CourierSystem::buildRegionTables()
+{
+    syncRoutingSnapshot();
+    const RoadSnapshot &roads = routingSnapshot;
+    int n = roads.cityIDs.size();
+    int parts = regions.parts;
+
+    regions.boundarySlot = Vector<int>(n, -1);
+    regions.boundary = Vector<Vector<int>>(parts, Vector<int>());
+    Vector<int> sources;
+    for (int u = 0; u < n; u++)
+    {
+        bool isBoundary = false;
+        for (int e = roads.offsets[u]; e < roads.offsets[u + 1] && !isBoundary; e++)
+        {
+            isBoundary = regions.regionOf[roads.targets[e]] != regions.regionOf[u];
+        }
+        for (int e = roads.reverseOffsets[u]; e < roads.reverseOffsets[u + 1] && !isBoundary; e++)
+        {
+            isBoundary = regions.regionOf[roads.reverseSources[e]] != regions.regionOf[u];
+        }
+        if (!isBoundary)
+            continue;
+
+        Vector<int> &list = regions.boundary[regions.regionOf[u]];
+        regions.boundarySlot[u] = list.size();
+        list.push_back(u);
+        sources.push_back(u);
+    }
+
+    regions.tables = Vector<Vector<int>>(parts, Vector<int>());
+    for (int r = 0; r < parts; r++)
+    {
+        int b = regions.boundary[r].size();
+        regions.tables[r] = Vector<int>(b * b, 2147483647);
+    }
+
+    int threadCount = static_cast<int>(thread::hardware_concurrency());
+    if (threadCount < 1)
+        threadCount = 1;
+    if (threadCount > sources.size())
+        threadCount = sources.size();
+
+    atomic<int> nextSource(0);
+    auto worker = [&]()
+    {
+        Vector<int> dist(n, 2147483647);
+        Vector<int> link(n, -1);
+        Vector<int> touched;
+        for (int s = nextSource++; s < sources.size(); s = nextSource++)
+        {
+            int u = sources[s];
+            int r = regions.regionOf[u];
+            const Vector<int> &list = regions.boundary[r];
+            int *row = &regions.tables[r][regions.boundarySlot[u] * list.size()];
+
+            touched.clear();
+            regionSearch(roads, regions.regionOf, u, false, dist, link, touched);
+            for (int j = 0; j < list.size(); j++)
+            {
+                row[j] = dist[list[j]];
+            }
+            for (int i = 0; i < touched.size(); i++)
+            {
+                dist[touched[i]] = 2147483647;
+            }
+        }
+    };
+
+    Vector<thread *> workers;
+    for (int t = 0; t < threadCount; t++)
+    {
+        workers.push_back(new thread(worker));
+    }
+    for (int t = 0; t < workers.size(); t++)
+    {
+        workers[t]->join();
+        delete workers[t];
+    }
+
+    regions.version = routingVersion;
+    regions.overloadVersion = routingOverloadVersion;
+}
+
+void CourierSystem::partitionNetwork(int regionCount)
+{
+    if (!partitionRegions(regionCount))
+    {
+        cout << "\n[ERROR] Region count must be between 2 and the number of cities.\n";
+        return;
+    }
+
+    const RoadSnapshot &roads = serviceSnapshot;
+    CSVUtils::saveRegionMap("regions.csv", roads.cityIDs, regions.regionOf, regions.boundarySlot);
+    CSVUtils::saveBoundaryTables("region_tables.csv", roads.cityIDs, regions.boundary, regions.tables);
+
+    Table t;
+    t.addHeader("Region");
+    t.addHeader("Cities");
+    t.addHeader("Active Parcels");
+    t.addHeader("Boundary Cities");
+    t.addHeader("Table Entries");
+    t.addHeader("Members");
+    for (int r = 0; r < regions.parts; r++)
+    {
+        string members;
+        int listed = 0;
+        for (int i = 0; i < roads.cityIDs.size() && listed < 4; i++)
+        {
+            if (regions.regionOf[i] != r)
+                continue;
+            City *c = cityMap.getNodeData(roads.cityIDs[i]);
+            members += (listed > 0 ? ", " : "") + (c ? c->name : to_string(roads.cityIDs[i]));
+            listed++;
+        }
+        if (regions.cityCount[r] > listed)
+            members += ", ...";
+
+        int b = regions.boundary[r].size();
+        t.addRow({to_string(r + 1), to_string(regions.cityCount[r]), to_string(regions.parcelCount[r]),
+                  to_string(b), to_string(b * b), members});
+    }
+
+    cout << "\n=== Regional Partition (" << regions.parts << " regions) ===\n";
+    t.print();
+    cout << "\n[INFO] " << regions.cutRoads << " of " << regions.totalRoads << " open roads cross region borders.\n";
+    cout << "[SUCCESS] Region map saved to regions.csv, boundary tables to region_tables.csv.\n";
+}
+
+int CourierSystem::calculateRegionalPath(int srcID, int destID, Vector<int> &path)
+{
+    path.clear();
+    if (regions.parts == 0)
+        return -1;
+
+    syncRoutingSnapshot();
+    const RoadSnapshot &roads = routingSnapshot;
+    int n = roads.cityIDs.size();
+    if (regions.regionOf.size() != n)
+        partitionRegions(regions.parts);
+    else if (regions.version != routingVersion || regions.overloadVersion != routingOverloadVersion)
+        buildRegionTables();
+
+    int src = connectivityIndexOf(srcID);
+    int dest = connectivityIndexOf(destID);
+    if (src == -1 || dest == -1)
+        return -1;
+
+    Vector<int> fromSource(n, 2147483647), sourceLink(n, -1);
+    Vector<int> toDest(n, 2147483647), destLink(n, -1);
+    Vector<int> touched;
+    regionSearch(roads, regions.regionOf, src, false, fromSource, sourceLink, touched);
+    regionSearch(roads, regions.regionOf, dest, true, toDest, destLink, touched);
+
+    long long best = fromSource[dest];
+    int bestExit = -1;
+
+    Vector<int> dist(n, 2147483647), previous(n, -1);
+    MinHeap<DijkstraNode> pq;
+    const Vector<int> &entry = regions.boundary[regions.regionOf[src]];
+    for (int i = 0; i < entry.size(); i++)
+    {
+        if (fromSource[entry[i]] == 2147483647)
+            continue;
+        dist[entry[i]] = fromSource[entry[i]];
+        pq.push({entry[i], dist[entry[i]]});
+    }
+
+    while (!pq.empty())
+    {
+        DijkstraNode current = pq.top();
+        pq.pop();
+
+        int u = current.id;
+        if (current.dist > dist[u])
+            continue;
+        if (current.dist >= best)
+            break;
+
+        int r = regions.regionOf[u];
+        if (r == regions.regionOf[dest] && toDest[u] != 2147483647 && current.dist + static_cast<long long>(toDest[u]) < best)
+        {
+            best = current.dist + static_cast<long long>(toDest[u]);
+            bestExit = u;
+        }
+
+        const Vector<int> &list = regions.boundary[r];
+        const int *row = &regions.tables[r][regions.boundarySlot[u] * list.size()];
+        for (int j = 0; j < list.size(); j++)
+        {
+            if (row[j] == 2147483647 || current.dist + row[j] >= dist[list[j]])
+                continue;
+            dist[list[j]] = current.dist + row[j];
+            previous[list[j]] = u;
+            pq.push({list[j], dist[list[j]]});
+        }
+        for (int e = roads.offsets[u]; e < roads.offsets[u + 1]; e++)
+        {
+            int v = roads.targets[e];
+            if (regions.regionOf[v] == r || current.dist + roads.weights[e] >= dist[v])
+                continue;
+            dist[v] = current.dist + roads.weights[e];
+            previous[v] = u;
+            pq.push({v, dist[v]});
+        }
+    }
+
+    if (best == 2147483647)
+        return -1;
+
+    if (bestExit == -1)
+    {
+        Vector<int> reversed;
+        for (int curr = dest; curr != -1; curr = sourceLink[curr])
+        {
+            reversed.push_back(roads.cityIDs[curr]);
+        }
+        for (int i = reversed.size() - 1; i >= 0; i--)
+        {
+            path.push_back(reversed[i]);
+        }
+        return static_cast<int>(best);
+    }
+
+    Vector<int> hops;
+    for (int curr = bestExit; curr != -1; curr = previous[curr])
+    {
+        hops.push_back(curr);
+    }
+
+    Vector<int> reversed;
+    for (int curr = hops[hops.size() - 1]; curr != -1; curr = sourceLink[curr])
+    {
+        reversed.push_back(roads.cityIDs[curr]);
+    }
+    for (int i = reversed.size() - 1; i >= 0; i--)
+    {
+        path.push_back(reversed[i]);
+    }
+
+    Vector<int> legDist(n, 2147483647), legLink(n, -1);
+    for (int h = hops.size() - 1; h > 0; h--)
+    {
+        int from = hops[h], to = hops[h - 1];
+        if (regions.regionOf[from] != regions.regionOf[to])
+        {
+            path.push_back(roads.cityIDs[to]);
+            continue;
+        }
+
+        touched.clear();
+        regionSearch(roads, regions.regionOf, from, false, legDist, legLink, touched);
+        reversed.clear();
+        for (int curr = to; curr != from; curr = legLink[curr])
+        {
+            reversed.push_back(roads.cityIDs[curr]);
+        }
+        for (int i = reversed.size() - 1; i >= 0; i--)
+        {
+            path.push_back(reversed[i]);
+        }
+        for (int i = 0; i < touched.size(); i++)
+        {
+            legDist[touched[i]] = 2147483647;
+        }
+    }
+
+    for (int curr = destLink[bestExit]; curr != -1; curr = destLink[curr])
+    {
+        path.push_back(roads.cityIDs[curr]);
+    }
+    return static_cast<int>(best);
+}
+
+void CourierSystem::displayRegionalRoute(int srcID, int destID)
+{
+    if (!validateCityID(srcID) || !validateCityID(destID))
+    {
+        cout << "\n[ERROR] Invalid city IDs.\n";
+        return;
+    }
+    if (regions.parts == 0)
+    {
+        cout << "\n[INFO] Network has not been partitioned yet.\n";
+        return;
+    }
+
+    Vector<int> path;
+    int distance = calculateRegionalPath(srcID, destID, path);
+    if (distance == -1)
+    {
+        cout << "\n[ERROR] No open route found between these cities.\n";
+        return;
+    }
+
+    cout << "\n=== Route via Regional Boundary Tables ===\n";
+    cout << "Total Distance: " << distance << " km\n";
+    cout << "Path: ";
+    int lastRegion = -1;
+    for (int i = 0; i < path.size(); i++)
+    {
+        City *c = cityMap.getNodeData(path[i]);
+        int region = regions.regionOf[connectivityIndexOf(path[i])];
+        cout << (c ? c->name : to_string(path[i]));
+        if (region != lastRegion)
+            cout << " [R" << region + 1 << "]";
+        lastRegion = region;
+        if (i < path.size() - 1)
+            cout << " -> ";
+    }
+    cout << "\n";
+}
+
+void CourierSystem::toUnitVector(double latitude, double longitude, double *out)
+{
+    const double DEG = 3.14159265358979323846 / 180.0;
+    out[0] = cos(latitude * DEG) * cos(longitude * DEG);
+    out[1] = cos(latitude * DEG) * sin(longitude * DEG);
+    out[2] = sin(latitude * DEG);
+}
+
+double CourierSystem::chordToKm(double chord)
+{
+    if (chord > 2)
+        chord = 2;
+    return 2 * EARTH_RADIUS_KM * asin(chord / 2);
+}
+
+double CourierSystem::kmToChord(double km)
+{
+    if (km >= 3.14159265358979323846 * EARTH_RADIUS_KM)
+        return 2;
+    return 2 * sin(km / (2 * EARTH_RADIUS_KM));
+}
+
+void CourierSystem::rebuildLocators()
+{
+    cityLocator.clear();
+    hubLocator.clear();
+
+    double point[3];
+    Vector<Graph<City>::GraphNode> &nodes = cityMap.getNodes();
+    for (int i = 0; i < nodes.size(); i++)
+    {
+        if (!nodes[i].data.hasLocation)
+            continue;
+        toUnitVector(nodes[i].data.latitude, nodes[i].data.longitude, point);
+        cityLocator.insert(nodes[i].id, point);
+    }
+    for (int i = 0; i < hubCities.size(); i++)
+    {
+        City *c = cityMap.getNodeData(hubCities[i]);
+        if (!c || !c->hasLocation)
+            continue;
+        toUnitVector(c->latitude, c->longitude, point);
+        hubLocator.insert(hubCities[i], point);
+    }
+    cityLocator.rebuild();
+    hubLocator.rebuild();
+}
+
+int CourierSystem::findNearestHub(double latitude, double longitude, double &distanceKm) const
+{
+    double point[3];
+    toUnitVector(latitude, longitude, point);
+
+    Vector<KDTree::Match> best;
+    hubLocator.nearest(point, 1, best);
+    if (best.empty())
+        return -1;
+    distanceKm = chordToKm(sqrt(best[0].dist2));
+    return best[0].id;
+}
+
+void CourierSystem::findNearestCities(double latitude, double longitude, int k, Vector<ReachableCity> &result) const
+{
+    double point[3];
+    toUnitVector(latitude, longitude, point);
+
+    Vector<KDTree::Match> best;
+    cityLocator.nearest(point, k, best);
+    result.clear();
+    for (int i = 0; i < best.size(); i++)
+    {
+        result.push_back(ReachableCity(best[i].id, static_cast<int>(chordToKm(sqrt(best[i].dist2)) + 0.5)));
+    }
+}
+
+void CourierSystem::findCitiesWithinRadius(double latitude, double longitude, int radiusKm, Vector<ReachableCity> &result) const
+{
+    double point[3];
+    toUnitVector(latitude, longitude, point);
+
+    Vector<KDTree::Match> found;
+    cityLocator.withinRadius(point, kmToChord(radiusKm), found);
+    result.clear();
+    for (int i = 0; i < found.size(); i++)
+    {
+        result.push_back(ReachableCity(found[i].id, static_cast<int>(chordToKm(sqrt(found[i].dist2)) + 0.5)));
+    }
+}
+
+void CourierSystem::resolveNearestHubs(const Vector<double> &latitudes, const Vector<double> &longitudes,
+                                       Vector<int> &hubIDs, Vector<double> &distancesKm) const
+{
+    int count = latitudes.size();
+    hubIDs = Vector<int>(count, -1);
+    distancesKm = Vector<double>(count, 0);
+    if (count == 0)
+        return;
+
+    const int BATCH = 1024;
+    int batches = (count + BATCH - 1) / BATCH;
+    int threadCount = static_cast<int>(thread::hardware_concurrency());
+    if (threadCount < 1)
+        threadCount = 1;
+    if (threadCount > batches)
+        threadCount = batches;
+
+    atomic<int> nextBatch(0);
+    auto worker = [&]()
+    {
+        for (int b = nextBatch++; b < batches; b = nextBatch++)
+        {
+            int end = (b + 1) * BATCH < count ? (b + 1) * BATCH : count;
+            for (int i = b * BATCH; i < end; i++)
+            {
+                hubIDs[i] = findNearestHub(latitudes[i], longitudes[i], distancesKm[i]);
+            }
+        }
+    };
+
+    Vector<thread *> workers;
+    for (int t = 0; t < threadCount; t++)
+    {
+        workers.push_back(new thread(worker));
+    }
+    for (int t = 0; t < workers.size(); t++)
+    {
+        workers[t]->join();
+        delete workers[t];
+    }
+}
+
+void CourierSystem::displayNearestHub(double latitude, double longitude)
+{
+    if (latitude < -90 || latitude > 90 || longitude < -180 || longitude > 180)
+    {
+        cout << "\n[ERROR] Coordinates out of range.\n";
+        return;
+    }
+    if (cityLocator.size() == 0)
+    {
+        cout << "\n[INFO] No cities have coordinates yet.\n";
+        return;
+    }
+
+    ostringstream where;
+    where << fixed << setprecision(4) << latitude << ", " << longitude;
+    cout << "\n=== Nearest Hub to (" << where.str() << ") ===\n";
+    double hubDistance;
+    int hubID = findNearestHub(latitude, longitude, hubDistance);
+    if (hubID == -1)
+    {
+        cout << "[INFO] No registered hub has coordinates.\n";
+    }
+    else
+    {
+        City *hub = cityMap.getNodeData(hubID);
+        cout << "Hub: " << (hub ? hub->name : to_string(hubID)) << " (ID: " << hubID << "), "
+             << static_cast<int>(hubDistance + 0.5) << " km away\n";
+    }
+
+    Vector<ReachableCity> nearby;
+    findNearestCities(latitude, longitude, 5, nearby);
+    Table t;
+    t.addHeader("City");
+    t.addHeader("Distance (km)");
+    for (int i = 0; i < nearby.size(); i++)
+    {
+        City *c = cityMap.getNodeData(nearby[i].cityID);
+        t.addRow({c ? c->name : to_string(nearby[i].cityID), to_string(nearby[i].distance)});
+    }
+    cout << "\nNearest Cities:\n";
+    t.print();
+}
+
+void CourierSystem::resolveHubsFromFile(const string &filename)
+{
+    Vector<double> latitudes, longitudes;
+    if (!CSVUtils::loadCoordinates(filename, latitudes, longitudes))
+    {
+        cout << "\n[ERROR] Could not open " << filename << ".\n";
+        return;
+    }
+    if (hubLocator.size() == 0)
+    {
+        cout << "\n[ERROR] No registered hub has coordinates.\n";
+        return;
+    }
+
+    clock_t started = clock();
+    Vector<int> hubIDs;
+    Vector<double> distances;
+    resolveNearestHubs(latitudes, longitudes, hubIDs, distances);
+    double seconds = static_cast<double>(clock() - started) / CLOCKS_PER_SEC;
+
+    CSVUtils::saveResolvedHubs("resolved_hubs.csv", latitudes, longitudes, hubIDs, distances);
+    ostringstream elapsed;
+    elapsed << fixed << setprecision(3) << seconds;
+    cout << "\n[SUCCESS] Resolved " << hubIDs.size() << " location(s) against " << hubLocator.size()
+         << " hub(s) in " << elapsed.str() << " s.\n";
+    cout << "[INFO] Results saved to resolved_hubs.csv.\n";
+}
+
+void CourierSystem::displayBlockedRoutes()
+{
+    Table t;
+    t.addHeader("Source ID");
+    t.addHeader("Destination ID");
+    t.addHeader("Status");
+
+    bool hasBlocked = false;
+    for (int i = 0; i < blockedEdges.size(); i++)
+    {
+        if (blockedEdges[i].isBlocked)
+        {
+            hasBlocked = true;
+            City *src = cityMap.getNodeData(blockedEdges[i].srcID);
+            City *dest = cityMap.getNodeData(blockedEdges[i].destID);
+            string srcName = src ? src->name : to_string(blockedEdges[i].srcID);
+            string destName = dest ? dest->name : to_string(blockedEdges[i].destID);
+            t.addRow({srcName, destName, "Blocked"});
+        }
+    }
+
+    if (!hasBlocked)
+    {
+        cout << "\n[INFO] No blocked routes.\n";
+        return;
+    }
+
+    cout << "\n=== Blocked Routes ===\n";
+    t.print();
+}
+
+void CourierSystem::recalculateActiveRoutes()
+{
+    if (trafficAssignmentEnabled)
+    {
+        runTrafficAssignment(true);
+        return;
+    }
+
+    rerouteActiveParcels(nullptr);
+}
+
+void CourierSystem::rerouteActiveParcels(const HashTable<long long, int> *onlyThrough)
+{
+    int count = 0;
+    for (int i = 0; i < allParcels.size(); i++)
+    {
+        if (allParcels[i].status != Status::InTransit)
+            continue;
+
+        if (onlyThrough)
+        {
+            bool affected = false;
+            Vector<int> route = getParcelRoute(allParcels[i]);
+            for (int j = 0; !affected && j + 1 < route.size(); j++)
+            {
+                affected = onlyThrough->contains(edgeKey(route[j], route[j + 1]));
+            }
+            if (!affected)
+                continue;
+        }
+
+        Vector<int> newPath;
+
+        releaseParcelRoute(allParcels[i]);
+        int startCity = (allParcels[i].currentCityID != -1) ? allParcels[i].currentCityID : allParcels[i].sourceCityID;
+        int dist = calculateShortestPath(startCity, allParcels[i].destCityID, newPath, true);
+        if (dist != -1)
+        {
+
+            setParcelRoute(allParcels[i], newPath);
+            discardRiderTour(allParcels[i].trackingID);
+            allParcels[i].history.push_back(getCurrentTimestamp() + " - Route recalculated due to network change");
+            count++;
+        }
+        else
+        {
+            setParcelRoute(allParcels[i], allParcels[i].routeID);
+        }
+    }
+    if (count > 0)
+    {
+        cout << "\n[INFO] Recalculated routes for " << count << " parcels in transit.\n";
+    }
+}
+
+long long CourierSystem::edgeKey(int srcID, int destID)
+{
+    int lo = srcID < destID ? srcID : destID;
+    int hi = srcID < destID ? destID : srcID;
+    return (static_cast<long long>(lo) << 32) | static_cast<unsigned int>(hi);
+}
+
+void CourierSystem::onNetworkChanged(bool rerouteAll)
+{
+    riderTours.clear();
+    pendingNetworkChanges++;
+    if (rerouteAll)
+        pendingFullReroute = true;
+    if (networkTransactionDepth == 0)
+        flushNetworkChanges();
+}
+
+void CourierSystem::onEdgeDegraded(int srcID, int destID)
+{
+    pendingNetworkChanges++;
+    pendingDegradedEdges.insert(edgeKey(srcID, destID), 1);
+    if (networkTransactionDepth == 0)
+        flushNetworkChanges();
+}
+
+void CourierSystem::flushNetworkChanges()
+{
+    if (pendingNetworkChanges == 0)
+        return;
+
+    graphVersion++;
+    if (pendingFullReroute || trafficAssignmentEnabled)
+    {
+        recalculateActiveRoutes();
+    }
+    else if (!pendingDegradedEdges.empty())
+    {
+        rerouteActiveParcels(&pendingDegradedEdges);
+    }
+
+    pendingNetworkChanges = 0;
+    pendingFullReroute = false;
+    pendingDegradedEdges.clear();
+}
+
+void CourierSystem::beginNetworkTransaction()
+{
+    networkTransactionDepth++;
+}
+
+void CourierSystem::commitNetworkTransaction()
+{
+    if (networkTransactionDepth == 0)
+    {
+        cout << "\n[ERROR] No network transaction in progress.\n";
+        return;
+    }
+
+    networkTransactionDepth--;
+    if (networkTransactionDepth > 0)
+        return;
+
+    int changes = pendingNetworkChanges;
+    flushNetworkChanges();
+    cout << "\n[INFO] Network transaction committed: " << changes << " change(s) applied with a single reroute.\n";
+}
+
+bool CourierSystem::inNetworkTransaction() const
+{
+    return networkTransactionDepth > 0;
+}
+
+void CourierSystem::applyNetworkEditsFromFile(const string &filename)
+{
+    ifstream file(filename);
+    if (!file.is_open())
+    {
+        cout << "\n[ERROR] Could not open " << filename << ".\n";
+        return;
+    }
+
+    int applied = 0, skipped = 0, lineNo = 0;
+    string line;
+
+    beginNetworkTransaction();
+    while (getline(file, line))
+    {
+        lineNo++;
+        if (!line.empty() && line[line.size() - 1] == '\r')
+            line.erase(line.size() - 1);
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        auto tokens = CSVUtils::split(line, ',');
+        string action = tokens[0];
+        for (size_t i = 0; i < action.size(); i++)
+            action[i] = toupper(action[i]);
+        if (lineNo == 1 && action == "ACTION")
+            continue;
+
+        int srcID = tokens.size() > 1 ? atoi(tokens[1].c_str()) : -1;
+        int destID = tokens.size() > 2 ? atoi(tokens[2].c_str()) : -1;
+        int value = tokens.size() > 3 ? atoi(tokens[3].c_str()) : -1;
+
+        bool ok = true;
+        if (action == "ADDCITY" && tokens.size() > 3 && !tokens[1].empty())
+            addCity(tokens[1], atof(tokens[2].c_str()), atof(tokens[3].c_str()));
+        else if (action == "ADDCITY" && tokens.size() > 1 && !tokens[1].empty())
+            addCity(tokens[1]);
+        else if (action == "ADDROUTE" && validateRoute(srcID, destID) && value > 0)
+            addRoute(srcID, destID, value);
+        else if (action == "BLOCK" && validateRoute(srcID, destID))
+            blockRoute(srcID, destID);
+        else if (action == "UNBLOCK" && validateRoute(srcID, destID))
+            unblockRoute(srcID, destID);
+        else if (action == "LOAD" && validateRoute(srcID, destID) && value >= 0)
+            markPathAsOverloaded(srcID, destID, value);
+        else if (action == "UNLOAD" && validateRoute(srcID, destID))
+            unmarkPathAsOverloaded(srcID, destID);
+        else if (action == "CAPACITY" && validateRoute(srcID, destID) && value > 0)
+            setRouteCapacity(srcID, destID, value);
+        else
+            ok = false;
+
+        if (ok)
+        {
+            applied++;
+        }
+        else
+        {
+            skipped++;
+            cout << "\n[WARNING] Line " << lineNo << " skipped: " << line << "\n";
+        }
+    }
+    file.close();
+
+    cout << "\n[INFO] " << applied << " edit(s) read from " << filename;
+    if (skipped > 0)
+        cout << ", " << skipped << " skipped";
+    cout << ".\n";
+    commitNetworkTransaction();
+}
+
+void CourierSystem::overlayDistances(const OverlayGraph::View &roads, int source, Vector<int> &dist, long long *cacheMisses)
+{
+    const int CACHE_LINE_INTS = 16;
+    const int CACHE_LINES = 512;
+    Vector<int> cachedLine(cacheMisses ? CACHE_LINES : 0, -1);
+    auto touch = [&](int index)
+    {
+        int line = index / CACHE_LINE_INTS;
+        if (cachedLine[line % CACHE_LINES] != line)
+        {
+            cachedLine[line % CACHE_LINES] = line;
+            (*cacheMisses)++;
+        }
+    };
+
+    for (int i = 0; i < dist.size(); i++)
+    {
+        dist[i] = 2147483647;
+    }
+
+    MinHeap<DijkstraNode> pq;
+    dist[source] = 0;
+    pq.push({source, 0});
+    while (!pq.empty())
+    {
+        DijkstraNode current = pq.top();
+        pq.pop();
+        if (cacheMisses)
+            touch(current.id);
+        if (current.dist > dist[current.id])
+            continue;
+
+        auto relax = [&](int v, int weight)
+        {
+            if (cacheMisses)
+                touch(v);
+            int newDist = current.dist + weight;
+            if (newDist < dist[v])
+            {
+                dist[v] = newDist;
+                pq.push({v, newDist});
+            }
+        };
+        roads.forEachNeighbor(current.id, relax);
+    }
+}
+
+void CourierSystem::benchmarkNodeOrdering(int cityCount, int queries)
+{
+    int side = 2;
+    while (side * side < cityCount)
+        side++;
+    int n = side * side;
+    if (queries < 1)
+        queries = 1;
+
+    unsigned int seed = 20240611u;
+    auto nextRandom = [&]()
+    {
+        seed = seed * 1103515245u + 12345u;
+        return static_cast<int>((seed >> 8) & 0x7FFFFF);
+    };
+
+    Vector<int> shuffled(n, 0);
+    for (int i = 0; i < n; i++)
+    {
+        shuffled[i] = i;
+    }
+    for (int i = n - 1; i > 0; i--)
+    {
+        int j = nextRandom() % (i + 1);
+        int tmp = shuffled[i];
+        shuffled[i] = shuffled[j];
+        shuffled[j] = tmp;
+    }
+
+    Graph<City> synthetic;
+    for (int i = 0; i < n; i++)
+    {
+        synthetic.addNode(shuffled[i] + 1, City(shuffled[i] + 1, ""));
+    }
+    for (int i = 0; i < n; i++)
+    {
+        int r = shuffled[i] / side, c = shuffled[i] % side;
+        if (c + 1 < side)
+        {
+            int w = 1 + nextRandom() % 20;
+            synthetic.addEdgeUnchecked(shuffled[i] + 1, shuffled[i] + 2, w);
+            synthetic.addEdgeUnchecked(shuffled[i] + 2, shuffled[i] + 1, w);
+        }
+        if (r + 1 < side)
+        {
+            int w = 1 + nextRandom() % 20;
+            synthetic.addEdgeUnchecked(shuffled[i] + 1, shuffled[i] + 1 + side, w);
+            synthetic.addEdgeUnchecked(shuffled[i] + 1 + side, shuffled[i] + 1, w);
+        }
+    }
+
+    Vector<int> sourceIDs;
+    for (int q = 0; q < queries; q++)
+    {
+        sourceIDs.push_back(1 + nextRandom() % n);
+    }
+
+    const OverlayGraph::NodeOrder orderings[3] = {OverlayGraph::NodeOrder::Input, OverlayGraph::NodeOrder::BreadthFirst,
+                                                  OverlayGraph::NodeOrder::ReverseCuthillMcKee};
+    const char *names[3] = {"Input Order", "Breadth-First", "Reverse Cuthill-McKee"};
+
+    Table t;
+    t.addHeader("Ordering");
+    t.addHeader("Build (ms)");
+    t.addHeader("Avg Query (ms)");
+    t.addHeader("Mean Index Gap");
+    t.addHeader("Est. Cache Misses/Query");
+    t.addHeader("vs Input");
+
+    long long checksum[3] = {0, 0, 0};
+    double baseMisses = 0;
+    for (int k = 0; k < 3; k++)
+    {
+        OverlayGraph network;
+        clock_t started = clock();
+        network.rebuild(synthetic, orderings[k]);
+        double buildMs = 1000.0 * (clock() - started) / CLOCKS_PER_SEC;
+        OverlayGraph::View roads = network.acquire();
+
+        long long edges = 0;
+        double gapSum = 0;
+        for (int u = 0; u < n; u++)
+        {
+            auto measure = [&](int v, int)
+            {
+                int gap = v > u ? v - u : u - v;
+                gapSum += gap;
+                edges++;
+            };
+            roads.forEachNeighbor(u, measure);
+        }
+
+        Vector<int> dist(n, 0);
+        started = clock();
+        for (int q = 0; q < queries; q++)
+        {
+            overlayDistances(roads, roads.indexOf(sourceIDs[q]), dist);
+            checksum[k] += dist[roads.indexOf(sourceIDs[(q + 1) % queries])];
+        }
+        double queryMs = 1000.0 * (clock() - started) / CLOCKS_PER_SEC / queries;
+
+        long long misses = 0;
+        int sampled = queries < 5 ? queries : 5;
+        for (int q = 0; q < sampled; q++)
+        {
+            overlayDistances(roads, roads.indexOf(sourceIDs[q]), dist, &misses);
+        }
+        double missesPerQuery = static_cast<double>(misses) / sampled;
+        if (k == 0)
+            baseMisses = missesPerQuery;
+
+        ostringstream build, query, gap, missText, change;
+        build << fixed << setprecision(1) << buildMs;
+        query << fixed << setprecision(2) << queryMs;
+        gap << fixed << setprecision(1) << (edges > 0 ? gapSum / edges : 0);
+        missText << fixed << setprecision(0) << missesPerQuery;
+        if (k == 0)
+            change << "-";
+        else
+            change << fixed << setprecision(1) << (baseMisses > 0 ? 100.0 * (baseMisses - missesPerQuery) / baseMisses : 0) << "% fewer misses";
+        t.addRow({names[k], build.str(), query.str(), gap.str(), missText.str(), change.str()});
+    }
+
+    cout << "\n=== Node Ordering Benchmark (" << n << " cities, " << queries << " queries) ===\n";
+    t.print();
+    cout << "\n[INFO] Cache misses are simulated on the distance array with a 32 KB direct-mapped cache of 64-byte lines.\n";
+    if (checksum[0] != checksum[1] || checksum[0] != checksum[2])
+        cout << "\n[ERROR] Orderings disagree on shortest distances.\n";
+    else
+        cout << "[SUCCESS] All orderings returned identical distances.\n";
+}
+
+void CourierSystem::importRoadNetwork(const string &filename)
+{
+    CSVUtils::ImportStats stats;
+    clock_t started = clock();
+    if (!CSVUtils::importEdgeList(filename, cityMap, stats, true, true))
+    {
+        cout << "\n[ERROR] Could not open " << filename << ".\n";
+        return;
+    }
+    roadNetwork.rebuild(cityMap, OverlayGraph::NodeOrder::ReverseCuthillMcKee);
+    double seconds = static_cast<double>(clock() - started) / CLOCKS_PER_SEC;
+
+    connectivityDirty = true;
+    onNetworkChanged();
+
+    ostringstream elapsed;
+    elapsed << fixed << setprecision(2) << seconds;
+
+    Table t;
+    t.addHeader("Metric");
+    t.addHeader("Value");
+    t.addRow({"Records Read", to_string(stats.linesRead)});
+    t.addRow({"Roads Added", to_string(stats.edgesAdded)});
+    t.addRow({"Duplicates Merged", to_string(stats.duplicates)});
+    t.addRow({"Records Skipped", to_string(stats.skipped)});
+    t.addRow({"Cities Created", to_string(stats.citiesCreated)});
+    t.addRow({"Peak Staging Memory (KB)", to_string(stats.peakBytes / 1024)});
+    t.addRow({"Elapsed (s)", elapsed.str()});
+    t.print();
+
+    cout << "\n[SUCCESS] Imported road network from " << filename << ".\n";
+    cout << "[INFO] Imported roads are kept for this session only; routes.csv is unchanged.\n";
+}
+
+const CourierSystem::OverloadedEdge *CourierSystem::findEdgeLoad(int srcID, int destID) const
+{
+    const int *index = edgeLoadIndex.get(edgeKey(srcID, destID));
+    return index ? &overloadedEdges[*index] : nullptr;
+}
+
+CourierSystem::OverloadedEdge &CourierSystem::edgeLoadEntry(int srcID, int destID)
+{
+    long long key = edgeKey(srcID, destID);
+    int *index = edgeLoadIndex.get(key);
+    if (index)
+    {
+        return overloadedEdges[*index];
+    }
+
+    overloadedEdges.push_back(OverloadedEdge(srcID, destID, 0, DEFAULT_EDGE_CAPACITY));
+    edgeLoadIndex.insert(key, overloadedEdges.size() - 1);
+    return overloadedEdges[overloadedEdges.size() - 1];
+}
+
+void CourierSystem::updateOverloadState(OverloadedEdge &edge)
+{
+    edge.currentLoad = edge.reportedLoad + edge.routedLoad;
+    if (!edge.overloaded && edge.currentLoad >= edge.maxCapacity)
+    {
+        edge.overloaded = true;
+        overloadVersion++;
+    }
+    else if (edge.overloaded && edge.currentLoad * 100 <= edge.maxCapacity * OVERLOAD_RELEASE_PERCENT)
+    {
+        edge.overloaded = false;
+        overloadVersion++;
+    }
+}
+
+void CourierSystem::adjustRouteLoad(const Vector<int> &route, int delta)
+{
+    for (int i = 0; i + 1 < route.size(); i++)
+    {
+        OverloadedEdge &edge = edgeLoadEntry(route[i], route[i + 1]);
+        edge.routedLoad += delta;
+        if (edge.routedLoad < 0)
+            edge.routedLoad = 0;
+        updateOverloadState(edge);
+    }
+}
+
+void CourierSystem::setParcelRoute(Parcel &parcel, const Vector<int> &route)
+{
+    int routeID = routePool.intern(route);
+    setParcelRoute(parcel, routeID);
+    routePool.release(routeID);
+}
+
+void CourierSystem::setParcelRoute(Parcel &parcel, int routeID)
+{
+    routePool.retain(routeID);
+    releaseParcelRoute(parcel);
+    routePool.release(parcel.routeID);
+    parcel.routeID = routeID;
+
+    if (routePool.length(routeID) > 1)
+    {
+        adjustRouteLoad(routePool.decode(routeID), 1);
+        routePool.retain(routeID);
+        routeLoads.insert(parcel.trackingID, routeID);
+    }
+}
+
+void CourierSystem::releaseParcelRoute(Parcel &parcel)
+{
+    int *counted = routeLoads.get(parcel.trackingID);
+    if (!counted)
+        return;
+
+    int routeID = *counted;
+    routeLoads.remove(parcel.trackingID);
+    adjustRouteLoad(routePool.decode(routeID), -1);
+    routePool.release(routeID);
+}
+
+Vector<int> CourierSystem::getParcelRoute(const Parcel &parcel) const
+{
+    return routePool.decode(parcel.routeID);
+}
+
+void CourierSystem::loadEdgeCapacities(const string &filename)
+{
+    ifstream file(filename);
+    if (!file.is_open())
+        return;
+
+    string line;
+    getline(file, line);
+    while (getline(file, line))
+    {
+        if (line.empty())
+            continue;
+        auto tokens = CSVUtils::split(line, ',');
+        if (tokens.size() < 3)
+            continue;
+
+        int srcID = stoi(tokens[0]);
+        int destID = stoi(tokens[1]);
+        int capacity = stoi(tokens[2]);
+        if (capacity > 0 && validateRoute(srcID, destID))
+        {
+            OverloadedEdge &edge = edgeLoadEntry(srcID, destID);
+            edge.maxCapacity = capacity;
+            updateOverloadState(edge);
+        }
+    }
+    file.close();
+}
+
+int CourierSystem::getEdgeCapacity(int srcID, int destID) const
+{
+    const OverloadedEdge *edge = findEdgeLoad(srcID, destID);
+    return edge ? edge->maxCapacity : DEFAULT_EDGE_CAPACITY;
+}
+
+int CourierSystem::routeParcelWithFlows(Parcel &parcel)
+{
+    OverlayGraph::View roads = roadNetwork.acquire();
+    int startCity = roads.indexOf(parcelOriginCity(parcel));
+    int destCity = roads.indexOf(parcel.destCityID);
+    if (startCity == -1 || destCity == -1)
+        return -1;
+
+    releaseParcelRoute(parcel);
+
+    const int n = roads.nodeCount();
+    Vector<int> dist(n, 2147483647);
+    Vector<int> parent(n, -1);
+    Vector<int> hopWeight(n, 0);
+    Vector<bool> visited(n, false);
+
+    for (int pass = 0; pass < 2; pass++)
+    {
+        bool allowOverCapacity = (pass == 1);
+        for (int i = 0; i < n; i++)
+        {
+            dist[i] = 2147483647;
+            parent[i] = -1;
+            visited[i] = false;
+        }
+
+        dist[startCity] = 0;
+        MinHeap<DijkstraNode> pq;
+        pq.push({startCity, 0});
+
+        while (!pq.empty())
+        {
+            DijkstraNode current = pq.top();
+            pq.pop();
+
+            int u = current.id;
+            if (visited[u] || current.dist > dist[u])
+                continue;
+            visited[u] = true;
+            if (u == destCity)
+                break;
+
+            int uID = roads.idAt(u);
+            auto relax = [&](int v, int weight)
+            {
+                int vID = roads.idAt(v);
+                if (isEdgeBlocked(uID, vID))
+                    return;
+
+                const OverloadedEdge *load = findEdgeLoad(uID, vID);
+                int flow = (load ? load->currentLoad : 0) + 1;
+                int capacity = load ? load->maxCapacity : DEFAULT_EDGE_CAPACITY;
+                if (capacity < 1)
+                    capacity = 1;
+                if (flow > capacity && !allowOverCapacity)
+                    return;
+
+                double ratio = static_cast<double>(flow) / capacity;
+                int cost = static_cast<int>(weight * (1.0 + 0.15 * ratio * ratio * ratio * ratio) + 0.5);
+                if (flow > capacity)
+                    cost += weight * 10;
+
+                if (dist[u] + cost < dist[v])
+                {
+                    dist[v] = dist[u] + cost;
+                    parent[v] = u;
+                    hopWeight[v] = weight;
+                    pq.push({v, dist[v]});
+                }
+            };
+            roads.forEachNeighbor(u, relax);
+        }
+
+        if (dist[destCity] != 2147483647)
+            break;
+    }
+
+    if (dist[destCity] == 2147483647)
+    {
+        setParcelRoute(parcel, parcel.routeID);
+        return -1;
+    }
+
+    int distance = 0;
+    Vector<int> reversedPath;
+    for (int curr = destCity; curr != -1; curr = parent[curr])
+    {
+        reversedPath.push_back(roads.idAt(curr));
+        distance += hopWeight[curr];
+    }
+    Vector<int> path;
+    for (int i = reversedPath.size() - 1; i >= 0; i--)
+    {
+        path.push_back(reversedPath[i]);
+    }
+
+    setParcelRoute(parcel, path);
+    trafficAssigned.insert(parcel.trackingID, graphVersion);
+    return distance;
+}
+
+void CourierSystem::setTrafficAssignmentMode(bool enabled)
+{
+    trafficAssignmentEnabled = enabled;
+    if (enabled)
+    {
+        cout << "\n[SUCCESS] Congestion-aware assignment enabled.\n";
+        runTrafficAssignment(true);
+    }
+    else
+    {
+        Vector<int> assigned = trafficAssigned.getAllKeys();
+        for (int i = 0; i < assigned.size(); i++)
+        {
+            trafficAssigned.remove(assigned[i]);
+        }
+        assignmentVersion = -1;
+        cout << "\n[SUCCESS] Congestion-aware assignment disabled. New parcels use shortest paths.\n";
+    }
+}
+
+bool CourierSystem::isTrafficAssignmentEnabled() const
+{
+    return trafficAssignmentEnabled;
+}
+
+void CourierSystem::runTrafficAssignment(bool fullRecompute)
+{
+    bool full = fullRecompute || assignmentVersion != graphVersion;
+
+    Vector<int> assigned = trafficAssigned.getAllKeys();
+    for (int i = 0; i < assigned.size(); i++)
+    {
+        Parcel *p = findParcel(assigned[i]);
+        if (full || !p || p->status != Status::InTransit)
+        {
+            trafficAssigned.remove(assigned[i]);
+        }
+    }
+
+    Vector<int> batch;
+    for (int i = 0; i < allParcels.size(); i++)
+    {
+        if (allParcels[i].status == Status::InTransit && !trafficAssigned.contains(allParcels[i].trackingID))
+        {
+            batch.push_back(i);
+            if (full)
+                releaseParcelRoute(allParcels[i]);
+        }
+    }
+
+    auto higherPriority = [&](int a, int b) -> bool
+    {
+        if (allParcels[a].priority != allParcels[b].priority)
+            return allParcels[a].priority < allParcels[b].priority;
+        return allParcels[a].trackingID < allParcels[b].trackingID;
+    };
+    sort(batch.begin(), batch.end(), higherPriority);
+
+    int routedCount = 0, unroutable = 0;
+    for (int i = 0; i < batch.size(); i++)
+    {
+        Parcel &parcel = allParcels[batch[i]];
+        int previous = parcel.routeID;
+        if (routeParcelWithFlows(parcel) == -1)
+        {
+            unroutable++;
+            continue;
+        }
+        routedCount++;
+        if (previous != parcel.routeID)
+            discardRiderTour(parcel.trackingID);
+
+        if (previous != RoutePool::NO_ROUTE && previous != parcel.routeID)
+        {
+            parcel.history.push_back(getCurrentTimestamp() + " - Route rebalanced by traffic assignment");
+        }
+    }
+
+    assignmentVersion = graphVersion;
+
+    if (routedCount > 0 || unroutable > 0)
+    {
+        cout << "\n[INFO] Traffic assignment (" << (full ? "full" : "incremental") << "): "
+             << routedCount << " parcel(s) routed";
+        if (unroutable > 0)
+            cout << ", " << unroutable << " without an open route";
+        cout << ".\n";
+    }
+}
+
+void CourierSystem::displayTrafficAssignment()
+{
+    if (!trafficAssignmentEnabled)
+    {
+        cout << "\n[INFO] Congestion-aware assignment is disabled.\n";
+        return;
+    }
+
+    runTrafficAssignment(false);
+
+    Table t;
+    t.addHeader("Source");
+    t.addHeader("Destination");
+    t.addHeader("Routed Parcels");
+    t.addHeader("Reported Load");
+    t.addHeader("Capacity");
+    t.addHeader("Utilization");
+
+    int rows = 0;
+    for (int i = 0; i < overloadedEdges.size(); i++)
+    {
+        const OverloadedEdge &edge = overloadedEdges[i];
+        if (edge.routedLoad == 0)
+            continue;
+
+        rows++;
+        City *src = cityMap.getNodeData(edge.srcID);
+        City *dest = cityMap.getNodeData(edge.destID);
+        t.addRow({src ? src->name : to_string(edge.srcID),
+                  dest ? dest->name : to_string(edge.destID),
+                  to_string(edge.routedLoad),
+                  to_string(edge.reportedLoad),
+                  to_string(edge.maxCapacity),
+                  to_string(edge.maxCapacity > 0 ? (edge.currentLoad * 100) / edge.maxCapacity : 0) + "%"});
+    }
+
+    if (rows == 0)
+    {
+        cout << "\n[INFO] No parcels in transit are currently assigned.\n";
+        return;
+    }
+
+    cout << "\n=== Traffic Assignment Flows ===\n";
+    t.print();
+}
+
+void CourierSystem::markPathAsOverloaded(int srcID, int destID, int load)
+{
+    if (!validateRoute(srcID, destID))
+    {
+        cout << "\n[ERROR] Invalid route.\n";
+        return;
+    }
+
+    if (load < 0)
+    {
+        cout << "\n[ERROR] Load cannot be negative.\n";
+        return;
+    }
+
+    OverloadedEdge &edge = edgeLoadEntry(srcID, destID);
+    bool increased = load > edge.reportedLoad;
+    bool wasOverloaded = edge.overloaded;
+    edge.reportedLoad = load;
+    updateOverloadState(edge);
+
+    cout << "\n[SUCCESS] Path load updated (Load: " << edge.currentLoad << "/" << edge.maxCapacity
+         << ", " << edge.routedLoad << " from routed parcels).\n";
+    if (edge.overloaded)
+    {
+        cout << "\n[WARNING] Path is at or over capacity! Consider blocking.\n";
+    }
+    if (increased)
+        onEdgeDegraded(srcID, destID);
+    else
+        onNetworkChanged(wasOverloaded && !edge.overloaded);
+}
+
+void CourierSystem::unmarkPathAsOverloaded(int srcID, int destID)
+{
+    const OverloadedEdge *existing = findEdgeLoad(srcID, destID);
+    if (!existing || (existing->reportedLoad == 0 && !existing->overloaded))
+    {
+        cout << "\n[INFO] Path not found in overloaded list.\n";
+        return;
+    }
+
+    OverloadedEdge &edge = edgeLoadEntry(srcID, destID);
+    bool wasOverloaded = edge.overloaded;
+    edge.reportedLoad = 0;
+    edge.overloaded = false;
+    updateOverloadState(edge);
+    if (wasOverloaded && !edge.overloaded)
+        overloadVersion++;
+
+    if (edge.overloaded)
+    {
+        cout << "\n[WARNING] Reported load cleared, but routed parcels still fill the path ("
+             << edge.currentLoad << "/" << edge.maxCapacity << ").\n";
+    }
+    else
+    {
+        cout << "\n[SUCCESS] Path overload status removed.\n";
+    }
+    onNetworkChanged(wasOverloaded && !edge.overloaded);
+}
+
+void CourierSystem::setRouteCapacity(int srcID, int destID, int capacity)
+{
+    if (!validateRoute(srcID, destID))
+    {
+        cout << "\n[ERROR] Invalid route.\n";
+        return;
+    }
+
+    if (capacity <= 0)
+    {
+        cout << "\n[ERROR] Capacity must be greater than 0.\n";
+        return;
+    }
+
+    OverloadedEdge &edge = edgeLoadEntry(srcID, destID);
+    bool reduced = capacity < edge.maxCapacity;
+    bool wasOverloaded = edge.overloaded;
+    edge.maxCapacity = capacity;
+    edge.overloaded = false;
+    updateOverloadState(edge);
+    if (wasOverloaded && !edge.overloaded)
+        overloadVersion++;
+    CSVUtils::saveEdgeCapacity("edge_capacities.csv", srcID, destID, capacity);
+
+    cout << "\n[SUCCESS] Capacity between " << srcID << " and " << destID << " set to " << capacity
+         << " (Load: " << edge.currentLoad << ").\n";
+    if (reduced)
+        onEdgeDegraded(srcID, destID);
+    else
+        onNetworkChanged();
+}
+
+bool CourierSystem::isPathOverloaded(int srcID, int destID) const
+{
+    const OverloadedEdge *edge = findEdgeLoad(srcID, destID);
+    return edge && edge->overloaded;
+}
+
+int CourierSystem::getEdgeLoadPermille(int srcID, int destID) const
+{
+    const OverloadedEdge *edge = findEdgeLoad(srcID, destID);
+    if (!edge || edge->maxCapacity <= 0)
+        return 0;
+    return (edge->currentLoad * 1000) / edge->maxCapacity;
+}
+
+void CourierSystem::displayOverloadedRoutes()
+{
+    Table t;
+    t.addHeader("Source ID");
+    t.addHeader("Destination ID");
+    t.addHeader("Current Load");
+    t.addHeader("Routed Parcels");
+    t.addHeader("Max Capacity");
+    t.addHeader("Status");
+
+    bool hasOverloaded = false;
+    for (int i = 0; i < overloadedEdges.size(); i++)
+    {
+        const OverloadedEdge &edge = overloadedEdges[i];
+        bool highLoad = edge.currentLoad * 100 >= edge.maxCapacity * HIGH_LOAD_PERCENT;
+        if (!edge.overloaded && !highLoad && edge.reportedLoad == 0)
+            continue;
+
+        hasOverloaded = true;
+        City *src = cityMap.getNodeData(edge.srcID);
+        City *dest = cityMap.getNodeData(edge.destID);
+        string srcName = src ? src->name : to_string(edge.srcID);
+        string destName = dest ? dest->name : to_string(edge.destID);
+        string status = edge.overloaded ? "OVERLOADED" : "High Load";
+
+        t.addRow({srcName,
+                  destName,
+                  to_string(edge.currentLoad),
+                  to_string(edge.routedLoad),
+                  to_string(edge.maxCapacity),
+                  status});
+    }
+
+    if (!hasOverloaded)
+    {
+        cout << "\n[INFO] No overloaded routes.\n";
+        return;
+    }
+
+    cout << "\n=== Overloaded Routes ===\n";
+    t.print();
+}
+
+Vector<Parcel> CourierSystem::getParcelsByWeightCategory(WeightCategory category)
+{
+    Vector<Parcel> result;
+    for (int i = 0; i < allParcels.size(); i++)
+    {
+        if (allParcels[i].getWeightCategory() == category)
+        {
+            result.push_back(allParcels[i]);
+        }
+    }
+    return result;
+}
+
+Vector<Parcel> CourierSystem::getParcelsByDestination(int destCityID)
+{
+    Vector<Parcel> result;
+    for (int i = 0; i < allParcels.size(); i++)
+    {
+        if (allParcels[i].destCityID == destCityID)
+        {
+            result.push_back(allParcels[i]);
+        }
+    }
+    return result;
+}
+
+void CourierSystem::sortParcelsByWeight(Vector<Parcel> &parcels)
+{
+
+    for (int i = 0; i < parcels.size(); i++)
+    {
+        for (int j = 0; j < parcels.size() - i - 1; j++)
+        {
+            if (parcels[j].weight > parcels[j + 1].weight)
+            {
+                Parcel temp = parcels[j];
+                parcels[j] = parcels[j + 1];
+                parcels[j + 1] = temp;
+            }
+        }
+    }
+}
+
+void CourierSystem::sortParcelsByDestination(Vector<Parcel> &parcels)
+{
+
+    for (int i = 0; i < parcels.size(); i++)
+    {
+        for (int j = 0; j < parcels.size() - i - 1; j++)
+        {
+            if (parcels[j].destCityID > parcels[j + 1].destCityID)
+            {
+                Parcel temp = parcels[j];
+                parcels[j] = parcels[j + 1];
+                parcels[j + 1] = temp;
+            }
+        }
+    }
+}
+
+void CourierSystem::displayParcelsByWeight()
+{
+    Table t;
+    t.addHeader("Tracking ID");
+    t.addHeader("Weight (kg)");
+    t.addHeader("Category");
+    t.addHeader("Priority");
+    t.addHeader("Status");
+
+    Vector<Parcel> sorted = allParcels;
+    sortParcelsByWeight(sorted);
+
+    for (int i = 0; i < sorted.size(); i++)
+    {
+        t.addRow({to_string(sorted[i].trackingID),
+                  to_string(sorted[i].weight),
+                  sorted[i].getWeightCategoryStr(),
+                  sorted[i].getPriorityStr(),
+                  sorted[i].getStatusStr()});
+    }
+
+    cout << "\n=== Parcels Sorted by Weight ===\n";
+    t.print();
+}
+
+void CourierSystem::displayParcelsByDestination()
+{
+    Table t;
+    t.setHeaderColor(BRIGHT_BLUE BOLD);
+    t.setBorderColor(CYAN);
+    t.setRowColor(WHITE);
+    t.addHeader("Tracking ID");
+    t.addHeader("Destination City");
+    t.addHeader("Priority");
+    t.addHeader("Status");
+
+    Vector<Parcel> sorted = allParcels;
+    sortParcelsByDestination(sorted);
+
+    for (int i = 0; i < sorted.size(); i++)
+    {
+        City *dest = cityMap.getNodeData(sorted[i].destCityID);
+        string destName = dest ? dest->name : to_string(sorted[i].destCityID);
+        t.addRow({to_string(sorted[i].trackingID),
+                  destName,
+                  sorted[i].getPriorityStr(),
+                  sorted[i].getStatusStr()});
+    }
+
+    int titleWidth = 45;
+    int totalWidth = titleWidth + 2;
+    cout << BRIGHT_BLUE BOLD;
+    cout << "\n";
+    cout << "┏";
+    for (int i = 0; i < totalWidth - 2; i++)
+        cout << "━";
+    cout << "┓\n";
+    cout << "┃";
+    int titleLen = 43;
+    int padding = (totalWidth - titleLen) / 2;
+    for (int i = 0; i < padding; i++)
+        cout << " ";
+    cout << "   Parcels Sorted by Destination   ";
+    for (int i = 0; i < padding - 1; i++)
+        cout << " ";
+    cout << "┃\n";
+    cout << "┗";
+    for (int i = 0; i < totalWidth - 2; i++)
+        cout << "━";
+    cout << "┛\n"
+         << RESET;
+    t.print();
+}
+
+void CourierSystem::sortParcelsByPriority(Vector<Parcel> &parcels)
+{
+
+    for (int i = 0; i < parcels.size(); i++)
+    {
+        for (int j = 0; j < parcels.size() - i - 1; j++)
+        {
+            if (parcels[j].priority > parcels[j + 1].priority)
+            {
+                Parcel temp = parcels[j];
+                parcels[j] = parcels[j + 1];
+                parcels[j + 1] = temp;
+            }
+        }
+    }
+}
+
+void CourierSystem::displayParcelsByPriority()
+{
+    Table t;
+    t.setHeaderColor(BRIGHT_GREEN BOLD);
+    t.setBorderColor(GREEN);
+    t.setRowColor(WHITE);
+    t.addHeader("Tracking ID");
+    t.addHeader("Priority");
+    t.addHeader("Weight (kg)");
+    t.addHeader("Status");
+    t.addHeader("Fragile");
+
+    Vector<Parcel> sorted = allParcels;
+    sortParcelsByPriority(sorted);
+
+    for (int i = 0; i < sorted.size(); i++)
+    {
+        t.addRow({to_string(sorted[i].trackingID),
+                  sorted[i].getPriorityStr(),
+                  to_string(sorted[i].weight),
+                  sorted[i].getStatusStr(),
+                  sorted[i].isFragile ? "Yes" : "No"});
+    }
+
+    int titleWidth = 45;
+    int totalWidth = titleWidth + 2;
+    cout << BRIGHT_GREEN BOLD;
+    cout << "\n";
+    cout << "┏";
+    for (int i = 0; i < totalWidth - 2; i++)
+        cout << "━";
+    cout << "┓\n";
+    cout << "┃";
+    int titleLen = 43;
+    int padding = (totalWidth - titleLen) / 2;
+    for (int i = 0; i < padding; i++)
+        cout << " ";
+    cout << "   Parcels Sorted by Priority   ";
+    for (int i = 0; i < padding - 1; i++)
+        cout << " ";
+    cout << "┃\n";
+    cout << "┗";
+    for (int i = 0; i < totalWidth - 2; i++)
+        cout << "━";
+    cout << "┛\n"
+         << RESET;
+    t.print();
+}
+
+Vector<Parcel> CourierSystem::getFragileParcels()
+{
+    Vector<Parcel> result;
+    for (int i = 0; i < allParcels.size(); i++)
+    {
+        if (allParcels[i].isFragile)
+        {
+            result.push_back(allParcels[i]);
+        }
+    }
+    return result;
+}
+
+void CourierSystem::markParcelAsFragile(int trackingID)
+{
+    Parcel *parcel = findParcel(trackingID);
+    if (!parcel)
+    {
+        cout << "\n[ERROR] Parcel ID not found.\n";
+        return;
+    }
+
+    parcel->isFragile = true;
+    parcel->history.push_back(getCurrentTimestamp() + " - Marked as Fragile");
+
+    if (parcel->status == Status::InWarehouse)
+    {
+        warehouseQueue.remove(*parcel);
+        warehouseQueue.push(*parcel);
+    }
+
+    saveData();
+    cout << "\n[SUCCESS] Parcel " << trackingID << " marked as fragile.\n";
+}
+
+void CourierSystem::processNextParcel()
+{
+    if (pickupQueue.empty())
+    {
+        cout << "\n[INFO] No pending parcels to process.\n";
+        return;
+    }
+
+    Parcel top = pickupQueue.front();
+    pickupQueue.pop();
+
+    Parcel *parcel = findParcel(top.trackingID);
+    if (!parcel)
+        return;
+
+    string prevState = parcel->getStatusStr();
+    parcel->status = Status::InWarehouse;
+    parcel->history.push_back(getCurrentTimestamp() + " - Processed at Warehouse");
+
+    warehouseQueue.push(*parcel);
+
+    saveData();
+
+    logOperation(OperationType::ProcessParcel, top.trackingID, prevState, "In Warehouse", -1);
+    cout << "\n[SUCCESS] Parcel " << top.trackingID << " (" << top.getPriorityStr() << ") moved to Warehouse.\n";
+}
+
+void CourierSystem::processParcelByID(int parcelID)
+{
+    Parcel *parcel = findParcel(parcelID);
+    if (!parcel)
+    {
+        cout << "\n[ERROR] Parcel ID not found.\n";
+        return;
+    }
+
+    if (parcel->status != Status::Pending)
+    {
+        cout << "\n[ERROR] Parcel is not in Pending status. Current status: " << parcel->getStatusStr() << "\n";
+        return;
+    }
+
+    if (!pickupQueue.remove(*parcel))
+    {
+        cout << "\n[WARNING] Parcel not found in pickup queue, but proceeding...\n";
+    }
+
+    string prevState = parcel->getStatusStr();
+    parcel->status = Status::InWarehouse;
+    parcel->history.push_back(getCurrentTimestamp() + " - Processed at Warehouse");
+
+    warehouseQueue.push(*parcel);
+
+    saveData();
+
+    logOperation(OperationType::ProcessParcel, parcelID, prevState, "In Warehouse", -1);
+    cout << "\n[SUCCESS] Parcel " << parcelID << " (" << parcel->getPriorityStr() << ") moved to Warehouse.\n";
+}
+
+void CourierSystem::assignRider()
+{
+    if (warehouseQueue.empty())
+    {
+        cout << "\n[INFO] No parcels waiting in Warehouse.\n";
+        return;
+    }
+
+    Parcel top = warehouseQueue.top();
+    warehouseQueue.pop();
+
+    Parcel *parcel = findParcel(top.trackingID);
+    if (!parcel)
+        return;
+
+    int riderID = findAvailableRider(parcel->weight, parcelOriginCity(*parcel));
+    if (riderID == -1)
+    {
+        cout << "\n[WARNING] No available rider found. Parcel remains in warehouse.\n";
+        warehouseQueue.push(*parcel);
+        return;
+    }
+
+    if (parcel->isFragile)
+    {
+        Rider *rider = findRider(riderID);
+        if (rider && rider->currentLoad > rider->capacity * 0.8)
+        {
+            cout << "\n[INFO] Fragile parcel assigned to rider with sufficient capacity buffer.\n";
+        }
+    }
+
+    assignRiderToParcel(parcel->trackingID, riderID);
+}
+
+void CourierSystem::assignRiderToParcel(int parcelID, int riderID)
+{
+    Parcel *parcel = findParcel(parcelID);
+    if (!parcel)
+    {
+        cout << "\n[ERROR] Parcel not found.\n";
+        return;
+    }
+
+    Rider *rider = findRider(riderID);
+    if (!rider)
+    {
+        cout << "\n[ERROR] Rider not found.\n";
+        return;
+    }
+
+    if (!rider->canCarry(parcel->weight))
+    {
+        cout << "\n[ERROR] Rider capacity exceeded. Cannot assign parcel.\n";
+        return;
+    }
+
+    applyAssignment(*parcel, *rider);
+    if (trafficAssignmentEnabled)
+        runTrafficAssignment(false);
+
+    saveData();
+
+    cout << "\n[SUCCESS] Parcel " << parcelID << " assigned to Rider " << rider->name << ".\n";
+}
+
+void CourierSystem::applyAssignment(Parcel &parcel, Rider &rider)
+{
+    string prevState = parcel.getStatusStr();
+    parcel.status = Status::InTransit;
+
+    int origin = parcelOriginCity(parcel);
+    Vector<int> route;
+    int dist = calculateShortestPath(origin, parcel.destCityID, route, true);
+    if (dist != -1)
+        setParcelRoute(parcel, route);
+    if (dist != -1 || trafficAssignmentEnabled)
+        parcel.currentCityID = origin;
+
+    parcel.history.push_back(getCurrentTimestamp() + " - Assigned to Rider " + rider.name);
+
+    rider.currentLoad += parcel.weight;
+    attachParcel(rider, parcel.trackingID);
+    touchRider(rider);
+
+    transitQueue.push(parcel);
+
+    logOperation(OperationType::AssignRider, parcel.trackingID, prevState, "In Transit", rider.riderID, origin);
+}
+
+int CourierSystem::parcelOriginCity(const Parcel &parcel)
+{
+    return (parcel.currentCityID != -1) ? parcel.currentCityID : parcel.sourceCityID;
+}
+
+void CourierSystem::planLinehaulConsolidation(int truckCapacity)
+{
+    clock_t started = clock();
+    if (truckCapacity <= 0)
+        truckCapacity = LINEHAUL_CAPACITY;
+    int minimumLoad = truckCapacity * LINEHAUL_MIN_FILL_PERCENT / 100;
+    syncServiceAreaCache();
+    const RoadSnapshot &roads = serviceSnapshot;
+    int n = roads.cityIDs.size();
+
+    Vector<Vector<int>> waveByOrigin(n, Vector<int>());
+    Vector<Parcel *> wave;
+    int waiting = 0;
+    for (int i = 0; i < allParcels.size(); i++)
+    {
+        if (allParcels[i].status != Status::InWarehouse)
+            continue;
+        waiting++;
+        int origin = connectivityIndexOf(parcelOriginCity(allParcels[i]));
+        int dest = connectivityIndexOf(allParcels[i].destCityID);
+        if (origin == -1 || dest == -1 || origin == dest || allParcels[i].weight > truckCapacity)
+            continue;
+        waveByOrigin[origin].push_back(wave.size());
+        wave.push_back(&allParcels[i]);
+    }
+
+    linehaulOrders.clear();
+    if (wave.empty())
+    {
+        cout << "\n[INFO] No warehouse parcels can travel by line-haul.\n";
+        return;
+    }
+
+    Vector<int> nodeCity, nodeParent, nodeDistance;
+    Vector<Vector<int>> pending;
+    Vector<long long> pendingKg;
+    HashTable<long long, int> children;
+    auto descend = [&](int parent, int city, int distance) -> int
+    {
+        long long key = (static_cast<long long>(parent + 1) << 32) | city;
+        int *child = children.get(key);
+        if (child)
+            return *child;
+        nodeCity.push_back(city);
+        nodeParent.push_back(parent);
+        nodeDistance.push_back(distance);
+        pending.push_back(Vector<int>());
+        pendingKg.push_back(0);
+        children.insert(key, nodeCity.size() - 1);
+        return nodeCity.size() - 1;
+    };
+
+    long long routeLength = 0;
+    int unroutable = 0;
+    Vector<int> dist, link, path;
+    for (int origin = 0; origin < n; origin++)
+    {
+        if (waveByOrigin[origin].empty())
+            continue;
+        snapshotTree(roads, origin, false, dist, link);
+        for (int i = 0; i < waveByOrigin[origin].size(); i++)
+        {
+            Parcel *parcel = wave[waveByOrigin[origin][i]];
+            int dest = connectivityIndexOf(parcel->destCityID);
+            if (dist[dest] == 2147483647)
+            {
+                unroutable++;
+                continue;
+            }
+
+            path.clear();
+            for (int city = dest; city != -1; city = link[city])
+            {
+                path.push_back(city);
+            }
+            int node = -1;
+            for (int k = path.size() - 1; k >= 0; k--)
+            {
+                node = descend(node, path[k], dist[path[k]]);
+            }
+            pending[node].push_back(waveByOrigin[origin][i]);
+            pendingKg[node] += parcel->weight;
+            routeLength += path.size();
+        }
+    }
+
+    int nextOrderID = 1;
+    long long parcelDistance = 0, truckDistance = 0;
+    int consolidated = 0, consolidatedKg = 0, individual = 0;
+    Vector<int> truck, leftover;
+    for (int node = nodeCity.size() - 1; node >= 0; node--)
+    {
+        int parent = nodeParent[node];
+        if (parent != -1 && pendingKg[node] >= minimumLoad)
+        {
+            int load = 0;
+            leftover.clear();
+            auto ship = [&]()
+            {
+                if (load < minimumLoad)
+                {
+                    for (int i = 0; i < truck.size(); i++)
+                    {
+                        leftover.push_back(truck[i]);
+                    }
+                }
+                else
+                {
+                    int root = node;
+                    Vector<int> reversed;
+                    for (; root != -1; root = nodeParent[root])
+                    {
+                        reversed.push_back(roads.cityIDs[nodeCity[root]]);
+                    }
+                    LinehaulOrder order(nextOrderID++, reversed[reversed.size() - 1], roads.cityIDs[nodeCity[node]], nodeDistance[node]);
+                    for (int i = reversed.size() - 1; i >= 0; i--)
+                    {
+                        order.corridor.push_back(reversed[i]);
+                    }
+                    for (int i = 0; i < truck.size(); i++)
+                    {
+                        order.trackingIDs.push_back(wave[truck[i]]->trackingID);
+                    }
+                    order.kilograms = load;
+                    linehaulOrders.push_back(order);
+                    consolidated += truck.size();
+                    consolidatedKg += load;
+                    parcelDistance += static_cast<long long>(truck.size()) * nodeDistance[node];
+                    truckDistance += nodeDistance[node];
+                }
+                truck.clear();
+                load = 0;
+            };
+
+            for (int i = 0; i < pending[node].size(); i++)
+            {
+                int weight = wave[pending[node][i]]->weight;
+                if (load + weight > truckCapacity)
+                    ship();
+                truck.push_back(pending[node][i]);
+                load += weight;
+            }
+            ship();
+            pending[node] = leftover;
+        }
+
+        if (parent == -1)
+        {
+            individual += pending[node].size();
+        }
+        else
+        {
+            for (int i = 0; i < pending[node].size(); i++)
+            {
+                pending[parent].push_back(pending[node][i]);
+                pendingKg[parent] += wave[pending[node][i]]->weight;
+            }
+        }
+        pending[node].clear();
+    }
+    individual += waiting - wave.size() + unroutable;
+    double elapsedMs = 1000.0 * (clock() - started) / CLOCKS_PER_SEC;
+
+    if (linehaulOrders.empty())
+    {
+        cout << "\n[INFO] No corridor carries enough warehouse freight to fill a " << truckCapacity
+             << " kg truck to " << LINEHAUL_MIN_FILL_PERCENT << "%.\n";
+        return;
+    }
+
+    Table t;
+    t.addHeader("Load");
+    t.addHeader("From");
+    t.addHeader("To");
+    t.addHeader("Hops");
+    t.addHeader("Parcels");
+    t.addHeader("Kg");
+    t.addHeader("Fill");
+    t.addHeader("Distance");
+    for (int i = 0; i < linehaulOrders.size(); i++)
+    {
+        const LinehaulOrder &order = linehaulOrders[i];
+        City *from = cityMap.getNodeData(order.fromCityID);
+        City *to = cityMap.getNodeData(order.toCityID);
+        t.addRow({"L" + to_string(order.orderID),
+                  from ? from->name : to_string(order.fromCityID),
+                  to ? to->name : to_string(order.toCityID),
+                  to_string(order.corridor.size() - 1),
+                  to_string(order.trackingIDs.size()),
+                  to_string(order.kilograms),
+                  to_string(order.kilograms * 100 / truckCapacity) + "%",
+                  to_string(order.distance)});
+    }
+
+    CSVUtils::saveLinehaulOrders("linehaul_orders.csv", linehaulOrders);
+
+    ostringstream timing;
+    timing << fixed << setprecision(1) << elapsedMs;
+    cout << "\n=== Line-Haul Consolidation (" << wave.size() << " parcel(s), " << routeLength << " route cities, "
+         << nodeCity.size() << " corridor nodes) ===\n";
+    t.print();
+    cout << "\n[SUCCESS] " << linehaulOrders.size() << " line-haul load(s) carry " << consolidated << " parcel(s) ("
+         << consolidatedKg << " kg): " << parcelDistance << " parcel-km moved with " << truckDistance
+         << " truck-km. Planned in " << timing.str() << " ms. Written to linehaul_orders.csv.\n";
+    if (individual > 0)
+        cout << "[INFO] " << individual << " warehouse parcel(s) stay on individual rider routes.\n";
+}
+
+void CourierSystem::dispatchLinehaulOrders()
+{
+    if (linehaulOrders.empty())
+    {
+        cout << "\n[INFO] No line-haul orders pending. Plan a consolidation first.\n";
+        return;
+    }
+
+    int moved = 0, stale = 0, loads = 0;
+    for (int i = 0; i < linehaulOrders.size(); i++)
+    {
+        const LinehaulOrder &order = linehaulOrders[i];
+        City *from = cityMap.getNodeData(order.fromCityID);
+        City *to = cityMap.getNodeData(order.toCityID);
+        string leg = "L" + to_string(order.orderID) + " " + (from ? from->name : to_string(order.fromCityID)) + " -> " +
+                     (to ? to->name : to_string(order.toCityID));
+        int before = moved;
+        for (int j = 0; j < order.trackingIDs.size(); j++)
+        {
+            Parcel *parcel = findParcel(order.trackingIDs[j]);
+            if (!parcel || parcel->status != Status::InWarehouse || parcelOriginCity(*parcel) != order.fromCityID)
+            {
+                stale++;
+                continue;
+            }
+            parcel->currentCityID = order.toCityID;
+            parcel->history.push_back(getCurrentTimestamp() + " - Line-haul " + leg);
+            moved++;
+        }
+        if (moved > before)
+            loads++;
+    }
+    linehaulOrders.clear();
+
+    if (moved > 0)
+    {
+        MinHeap<Parcel> rebuilt;
+        while (!warehouseQueue.empty())
+        {
+            Parcel *parcel = findParcel(warehouseQueue.top().trackingID);
+            warehouseQueue.pop();
+            if (parcel)
+                rebuilt.push(*parcel);
+        }
+        warehouseQueue = rebuilt;
+        saveData();
+    }
+
+    cout << "\n[SUCCESS] " << loads << " line-haul load(s) dispatched, " << moved << " parcel(s) moved to their corridor hubs.";
+    if (stale > 0)
+        cout << " " << stale << " parcel(s) skipped because they left the warehouse since planning.";
+    cout << "\n";
+}
+
+void CourierSystem::planGreedyDispatch(const DispatchProblem &problem, DispatchPlan &plan)
+{
+    int n = problem.weight.size();
+    Vector<int> remaining;
+    for (int r = 0; r < problem.capacity.size(); r++)
+    {
+        remaining.push_back(problem.capacity[r] - problem.load[r]);
+    }
+
+    plan.choice = Vector<int>(n, -1);
+    for (int p = 0; p < n; p++)
+    {
+        for (int c = 0; c < problem.candidateSlot[p].size(); c++)
+        {
+            int r = problem.candidateSlot[p][c];
+            if (remaining[r] >= problem.weight[p])
+            {
+                plan.choice[p] = c;
+                remaining[r] -= problem.weight[p];
+                break;
+            }
+        }
+    }
+    scoreDispatch(problem, plan);
+}
+
+void CourierSystem::planBatchDispatch(const DispatchProblem &problem, DispatchPlan &plan)
+{
+    int n = problem.weight.size();
+    int slots = problem.capacity.size();
+    Vector<int> remaining;
+    Vector<Vector<int>> carried(slots, Vector<int>());
+    for (int r = 0; r < slots; r++)
+    {
+        remaining.push_back(problem.capacity[r] - problem.load[r]);
+    }
+
+    Vector<int> order;
+    for (int p = 0; p < n; p++)
+    {
+        order.push_back(p);
+    }
+    auto packFirst = [&](int a, int b) -> bool
+    {
+        if (problem.score[a] != problem.score[b])
+            return problem.score[a] > problem.score[b];
+        if (problem.weight[a] != problem.weight[b])
+            return problem.weight[a] > problem.weight[b];
+        return a < b;
+    };
+    sort(order.begin(), order.end(), packFirst);
+
+    auto place = [&](int p, int c)
+    {
+        int r = problem.candidateSlot[p][c];
+        plan.choice[p] = c;
+        remaining[r] -= problem.weight[p];
+        carried[r].push_back(p);
+    };
+    auto unplace = [&](int p)
+    {
+        int r = problem.candidateSlot[p][plan.choice[p]];
+        plan.choice[p] = -1;
+        remaining[r] += problem.weight[p];
+        for (int i = 0; i < carried[r].size(); i++)
+        {
+            if (carried[r][i] == p)
+            {
+                carried[r][i] = carried[r][carried[r].size() - 1];
+                carried[r].pop_back();
+                break;
+            }
+        }
+    };
+
+    plan.choice = Vector<int>(n, -1);
+    for (int i = 0; i < n; i++)
+    {
+        int p = order[i];
+        int best = -1;
+        bool bestCramped = true;
+        for (int c = 0; c < problem.candidateSlot[p].size(); c++)
+        {
+            int r = problem.candidateSlot[p][c];
+            if (remaining[r] < problem.weight[p])
+                continue;
+
+            int loadAfter = problem.capacity[r] - remaining[r] + problem.weight[p];
+            bool cramped = problem.fragile[p] && loadAfter * 5 > problem.capacity[r] * 4;
+            if (best == -1 || (bestCramped && !cramped))
+            {
+                best = c;
+                bestCramped = cramped;
+            }
+        }
+        if (best != -1)
+            place(p, best);
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        int p = order[i];
+        if (plan.choice[p] != -1)
+            continue;
+
+        for (int c = 0; c < problem.candidateSlot[p].size() && plan.choice[p] == -1; c++)
+        {
+            int r = problem.candidateSlot[p][c];
+            int shortfall = problem.weight[p] - remaining[r];
+            if (shortfall <= 0)
+            {
+                place(p, c);
+                break;
+            }
+
+            int moveParcel = -1, moveTo = -1, moveCost = 0;
+            for (int j = 0; j < carried[r].size(); j++)
+            {
+                int q = carried[r][j];
+                if (problem.weight[q] < shortfall)
+                    continue;
+                for (int c2 = 0; c2 < problem.candidateSlot[q].size(); c2++)
+                {
+                    int r2 = problem.candidateSlot[q][c2];
+                    if (r2 == r || remaining[r2] < problem.weight[q])
+                        continue;
+                    int cost = problem.candidateDistance[q][c2] - problem.candidateDistance[q][plan.choice[q]];
+                    if (moveParcel == -1 || cost < moveCost)
+                    {
+                        moveParcel = q;
+                        moveTo = c2;
+                        moveCost = cost;
+                    }
+                }
+            }
+
+            if (moveParcel != -1)
+            {
+                unplace(moveParcel);
+                place(moveParcel, moveTo);
+                place(p, c);
+            }
+        }
+    }
+    scoreDispatch(problem, plan);
+}
+
+void CourierSystem::scoreDispatch(const DispatchProblem &problem, DispatchPlan &plan)
+{
+    plan.assigned = 0;
+    plan.kilograms = 0;
+    plan.score = 0;
+    plan.distance = 0;
+    for (int p = 0; p < plan.choice.size(); p++)
+    {
+        if (plan.choice[p] == -1)
+            continue;
+        plan.assigned++;
+        plan.kilograms += problem.weight[p];
+        plan.score += problem.score[p];
+        plan.distance += problem.candidateDistance[p][plan.choice[p]];
+    }
+}
+
+void CourierSystem::batchAssignRiders(int limit)
+{
+    if (warehouseQueue.empty())
+    {
+        cout << "\n[INFO] No parcels waiting in Warehouse.\n";
+        return;
+    }
+
+    Vector<Parcel *> batch;
+    while (!warehouseQueue.empty() && (limit <= 0 || batch.size() < limit))
+    {
+        Parcel top = warehouseQueue.top();
+        warehouseQueue.pop();
+        Parcel *parcel = findParcel(top.trackingID);
+        if (parcel)
+            batch.push_back(parcel);
+    }
+
+    DispatchProblem problem;
+    HashTable<int, int> slotOf;
+    for (int p = 0; p < batch.size(); p++)
+    {
+        Parcel *parcel = batch[p];
+        problem.weight.push_back(parcel->weight);
+        problem.score.push_back(4 - static_cast<int>(parcel->priority));
+        problem.fragile.push_back(parcel->isFragile);
+        problem.candidateSlot.push_back(Vector<int>());
+        problem.candidateDistance.push_back(Vector<int>());
+
+        Vector<RiderMatch> matches;
+        findNearestRiders(parcelOriginCity(*parcel), parcel->weight, DISPATCH_CANDIDATES, matches);
+        for (int i = 0; i < matches.size(); i++)
+        {
+            int *slot = slotOf.get(matches[i].riderID);
+            if (!slot)
+            {
+                Rider *rider = findRider(matches[i].riderID);
+                slotOf.insert(rider->riderID, problem.riderIDs.size());
+                problem.riderIDs.push_back(rider->riderID);
+                problem.capacity.push_back(rider->capacity);
+                problem.load.push_back(rider->currentLoad);
+                slot = slotOf.get(rider->riderID);
+            }
+            problem.candidateSlot[p].push_back(*slot);
+            problem.candidateDistance[p].push_back(matches[i].distance);
+        }
+    }
+
+    DispatchPlan greedy, plan;
+    planGreedyDispatch(problem, greedy);
+    planBatchDispatch(problem, plan);
+    if (plan.score < greedy.score || (plan.score == greedy.score && plan.distance > greedy.distance))
+        plan = greedy;
+
+    for (int p = 0; p < batch.size(); p++)
+    {
+        if (plan.choice[p] == -1)
+        {
+            warehouseQueue.push(*batch[p]);
+            continue;
+        }
+        Rider *rider = findRider(problem.riderIDs[problem.candidateSlot[p][plan.choice[p]]]);
+        applyAssignment(*batch[p], *rider);
+    }
+    if (plan.assigned > 0)
+    {
+        if (trafficAssignmentEnabled)
+            runTrafficAssignment(false);
+        saveData();
+    }
+
+    Table t;
+    t.addHeader("Metric");
+    t.addHeader("Greedy");
+    t.addHeader("Batch");
+    t.addRow({"Parcels assigned", to_string(greedy.assigned), to_string(plan.assigned)});
+    t.addRow({"Weight assigned (kg)", to_string(greedy.kilograms), to_string(plan.kilograms)});
+    t.addRow({"Priority score", to_string(greedy.score), to_string(plan.score)});
+    t.addRow({"Total pickup distance", to_string(greedy.distance), to_string(plan.distance)});
+
+    cout << "\n=== Batch Dispatch (" << batch.size() << " parcel(s), " << problem.riderIDs.size() << " candidate rider(s)) ===\n";
+    t.print();
+    cout << "\n[SUCCESS] " << plan.assigned << " parcel(s) assigned in one transaction; "
+         << batch.size() - plan.assigned << " remain in warehouse.\n";
+}
+
+int CourierSystem::findAvailableRider(int requiredCapacity, int cityID)
+{
+    drainLocationUpdates();
+    syncShiftClock();
+    if (roadMatchingEnabled)
+    {
+        int distance;
+        return findNearestRiderByRoad(requiredCapacity, cityID, distance);
+    }
+
+    MinHeap<RiderSlot> *local = ridersByCity.get(cityID);
+    int bestRider = local ? bestRiderIn(*local, requiredCapacity) : -1;
+    if (bestRider != -1)
+        return bestRider;
+
+    int bestAvailableCapacity = -1;
+    int bestDistance = -1;
+    LinkedList<Graph<City>::Edge> *neighbors = cityMap.getNeighbors(cityID);
+    if (neighbors)
+    {
+        for (auto &edge : *neighbors)
+        {
+            MinHeap<RiderSlot> *bucket = ridersByCity.get(edge.destID);
+            if (!bucket || isEdgeBlocked(cityID, edge.destID))
+                continue;
+
+            int candidate = bestRiderIn(*bucket, requiredCapacity);
+            if (candidate == -1)
+                continue;
+
+            int available = findRider(candidate)->getAvailableCapacity();
+            if (bestRider == -1 || edge.weight < bestDistance ||
+                (edge.weight == bestDistance && available > bestAvailableCapacity))
+            {
+                bestRider = candidate;
+                bestAvailableCapacity = available;
+                bestDistance = edge.weight;
+            }
+        }
+    }
+    if (bestRider != -1)
+        return bestRider;
+
+    bestRider = bestRiderIn(ridersByCapacity, requiredCapacity);
+    if (bestRider != -1)
+    {
+        Rider *rider = findRider(bestRider);
+        if (rider->currentCityID != cityID)
+        {
+            cout << "[INFO] Rider " << rider->name << " is moving from city " << rider->currentCityID
+                 << " to city " << cityID << " for pickup.\n";
+            rider->currentCityID = cityID;
+            touchRider(*rider);
+        }
+    }
+
+    return bestRider;
+}
+
+void CourierSystem::prepareMatchSearch()
+{
+    syncServiceAreaCache();
+    int n = serviceSnapshot.cityIDs.size();
+    while (matchDist.size() < n)
+    {
+        matchDist.push_back(2147483647);
+        matchOwner.push_back(-1);
+        matchSettled.push_back(false);
+    }
+}
+
+int CourierSystem::findNearestRiderByRoad(int requiredCapacity, int cityID, int &distance)
+{
+    distance = -1;
+    drainLocationUpdates();
+    syncShiftClock();
+    prepareMatchSearch();
+    const RoadSnapshot &roads = serviceSnapshot;
+    int target = connectivityIndexOf(cityID);
+    if (target == -1)
+        return -1;
+
+    Vector<RiderSlot> seeds;
+    Vector<int> touched;
+    MinHeap<DijkstraNode> pq;
+    Vector<int> cities = ridersByCity.getAllKeys();
+    for (int i = 0; i < cities.size(); i++)
+    {
+        int source = connectivityIndexOf(cities[i]);
+        if (source == -1)
+            continue;
+        int best = bestRiderIn(*ridersByCity.get(cities[i]), requiredCapacity);
+        if (best == -1)
+            continue;
+
+        RiderSlot seed = {findRider(best)->getAvailableCapacity(), best, 0};
+        seeds.push_back(seed);
+        matchDist[source] = 0;
+        matchOwner[source] = seeds.size() - 1;
+        touched.push_back(source);
+        pq.push({source, 0});
+    }
+
+    int bestRider = -1;
+    while (!pq.empty())
+    {
+        DijkstraNode current = pq.top();
+        pq.pop();
+
+        int u = current.id;
+        if (matchSettled[u] || current.dist > matchDist[u])
+            continue;
+        matchSettled[u] = true;
+
+        if (u == target)
+        {
+            bestRider = seeds[matchOwner[u]].riderID;
+            distance = current.dist;
+            break;
+        }
+
+        for (int e = roads.offsets[u]; e < roads.offsets[u + 1]; e++)
+        {
+            int v = roads.targets[e];
+            int newDist = current.dist + roads.weights[e];
+            if (matchSettled[v] || newDist > matchDist[v])
+                continue;
+            if (newDist == matchDist[v] && !(seeds[matchOwner[u]] < seeds[matchOwner[v]]))
+                continue;
+
+            if (matchDist[v] == 2147483647)
+                touched.push_back(v);
+            matchDist[v] = newDist;
+            matchOwner[v] = matchOwner[u];
+            pq.push({v, newDist});
+        }
+    }
+
+    for (int i = 0; i < touched.size(); i++)
+    {
+        matchDist[touched[i]] = 2147483647;
+        matchOwner[touched[i]] = -1;
+        matchSettled[touched[i]] = false;
+    }
+    return bestRider;
+}
+
+int CourierSystem::findNearestRiders(int cityID, int requiredCapacity, int k, Vector<RiderMatch> &matches)
+{
+    matches.clear();
+    drainLocationUpdates();
+    syncShiftClock();
+    prepareMatchSearch();
+    const RoadSnapshot &roads = serviceSnapshot;
+    int source = connectivityIndexOf(cityID);
+    if (source == -1 || k <= 0)
+        return 0;
+
+    Vector<int> touched;
+    MinHeap<DijkstraNode> pq;
+    matchDist[source] = 0;
+    touched.push_back(source);
+    pq.push({source, 0});
+
+    while (!pq.empty() && matches.size() < k)
+    {
+        DijkstraNode current = pq.top();
+        pq.pop();
+
+        int u = current.id;
+        if (current.dist > matchDist[u])
+            continue;
+
+        MinHeap<RiderSlot> *bucket = ridersByCity.get(roads.cityIDs[u]);
+        if (bucket)
+        {
+            Vector<RiderSlot> taken;
+            while (matches.size() < k)
+            {
+                int riderID = bestRiderIn(*bucket, requiredCapacity);
+                if (riderID == -1)
+                    break;
+                taken.push_back(bucket->top());
+                bucket->pop();
+                matches.push_back(RiderMatch(riderID, roads.cityIDs[u], current.dist));
+            }
+            for (int i = 0; i < taken.size(); i++)
+            {
+                bucket->push(taken[i]);
+            }
+        }
+
+        for (int e = roads.reverseOffsets[u]; e < roads.reverseOffsets[u + 1]; e++)
+        {
+            int v = roads.reverseSources[e];
+            int newDist = current.dist + roads.reverseWeights[e];
+            if (newDist >= matchDist[v])
+                continue;
+
+            if (matchDist[v] == 2147483647)
+                touched.push_back(v);
+            matchDist[v] = newDist;
+            pq.push({v, newDist});
+        }
+    }
+
+    for (int i = 0; i < touched.size(); i++)
+    {
+        matchDist[touched[i]] = 2147483647;
+    }
+    return matches.size();
+}
+
+void CourierSystem::setRoadMatchingMode(bool enabled)
+{
+    roadMatchingEnabled = enabled;
+    if (enabled)
+        cout << "\n[SUCCESS] Riders are now matched by road distance over open routes.\n";
+    else
+        cout << "\n[SUCCESS] Riders are now matched locally, with relocation as a fallback.\n";
+}
+
+bool CourierSystem::isRoadMatchingEnabled() const
+{
+    return roadMatchingEnabled;
+}
+
+void CourierSystem::completeDelivery()
+{
+    if (transitQueue.empty())
+    {
+        cout << "\n[INFO] No parcels currently in Transit.\n";
+        return;
+    }
+
+    Parcel top = transitQueue.front();
+    transitQueue.pop();
+
+    Parcel *parcel = findParcel(top.trackingID);
+    if (!parcel)
+        return;
+
+    string prevState = parcel->getStatusStr();
+    releaseParcelRoute(*parcel);
+    parcel->status = Status::Delivered;
+    parcel->currentCityID = parcel->destCityID;
+
+    City *destCity = cityMap.getNodeData(parcel->destCityID);
+    string destName = destCity ? destCity->name : to_string(parcel->destCityID);
+    parcel->history.push_back(getCurrentTimestamp() + " - Delivered to " + parcel->receiverName + " at " + destName);
+
+    int assignedRiderID = -1;
+    Rider *rider = detachParcel(parcel->trackingID);
+    if (rider)
+    {
+        assignedRiderID = rider->riderID;
+        rider->currentLoad -= parcel->weight;
+        rider->currentCityID = parcel->destCityID;
+        touchRider(*rider);
+    }
+
+    saveData();
+
+    logOperation(OperationType::CompleteDelivery, top.trackingID, prevState, "Delivered", assignedRiderID);
+    cout << "\n[SUCCESS] Parcel " << top.trackingID << " Delivered to " << destName << "!\n";
+}
+
+void CourierSystem::completeDeliveryByID(int parcelID)
+{
+    Parcel *parcel = findParcel(parcelID);
+    if (!parcel)
+    {
+        cout << "\n[ERROR] Parcel ID not found.\n";
+        return;
+    }
+
+    if (parcel->status != Status::InTransit)
+    {
+        cout << "\n[ERROR] Parcel is not in Transit status. Current status: " << parcel->getStatusStr() << "\n";
+        return;
+    }
+
+    if (!transitQueue.remove(*parcel))
+    {
+        cout << "\n[WARNING] Parcel not found in transit queue, but proceeding...\n";
+    }
+
+    string prevState = parcel->getStatusStr();
+    releaseParcelRoute(*parcel);
+    parcel->status = Status::Delivered;
+    parcel->currentCityID = parcel->destCityID;
+
+    City *destCity = cityMap.getNodeData(parcel->destCityID);
+    string destName = destCity ? destCity->name : to_string(parcel->destCityID);
+    parcel->history.push_back(getCurrentTimestamp() + " - Delivered to " + parcel->receiverName + " at " + destName);
+
+    int assignedRiderID = -1;
+    Rider *rider = detachParcel(parcelID);
+    if (rider)
+    {
+        assignedRiderID = rider->riderID;
+        rider->currentLoad -= parcel->weight;
+        rider->currentCityID = parcel->destCityID;
+        touchRider(*rider);
+    }
+
+    saveData();
+
+    logOperation(OperationType::CompleteDelivery, parcelID, prevState, "Delivered", assignedRiderID);
+    cout << "\n[SUCCESS] Parcel " << parcelID << " Delivered to " << destName << "!\n";
+}
+
+void CourierSystem::recordDispatch(int trackingID)
+{
+    Parcel *parcel = findParcel(trackingID);
+    if (!parcel)
+    {
+        cout << "\n[ERROR] Parcel ID " << trackingID << " not found.\n";
+        return;
+    }
+    if (parcel->status != Status::InWarehouse && parcel->status != Status::InTransit)
+    {
+        cout << "\n[WARNING] Parcel is not in Warehouse or Transit status. Current: " << parcel->getStatusStr() << "\n";
+    }
+    parcel->history.push_back(getCurrentTimestamp() + " - Dispatched from warehouse");
+    saveData();
+    cout << "\n[SUCCESS] Dispatch recorded for parcel " << trackingID << ".\n";
+}
+
+void CourierSystem::recordLoading(int trackingID, int cityID)
+{
+    Parcel *parcel = findParcel(trackingID);
+    if (!parcel)
+    {
+        cout << "\n[ERROR] Parcel ID " << trackingID << " not found.\n";
+        return;
+    }
+    if (!validateCityID(cityID))
+    {
+        cout << "\n[ERROR] Invalid City ID: " << cityID << "\n";
+        return;
+    }
+    City *city = cityMap.getNodeData(cityID);
+    string cityName = city ? city->name : to_string(cityID);
+    parcel->history.push_back(getCurrentTimestamp() + " - Loaded at " + cityName);
+    parcel->currentCityID = cityID;
+    saveData();
+    cout << "\n[SUCCESS] Loading recorded for parcel " << trackingID << " at " << cityName << ".\n";
+}
+
+void CourierSystem::recordUnloading(int trackingID, int cityID)
+{
+    Parcel *parcel = findParcel(trackingID);
+    if (!parcel)
+    {
+        cout << "\n[ERROR] Parcel ID " << trackingID << " not found.\n";
+        return;
+    }
+    if (!validateCityID(cityID))
+    {
+        cout << "\n[ERROR] Invalid City ID: " << cityID << "\n";
+        return;
+    }
+    City *city = cityMap.getNodeData(cityID);
+    string cityName = city ? city->name : to_string(cityID);
+    parcel->history.push_back(getCurrentTimestamp() + " - Unloaded at " + cityName);
+    parcel->currentCityID = cityID;
+    saveData();
+    cout << "\n[SUCCESS] Unloading recorded for parcel " << trackingID << " at " << cityName << ".\n";
+}
+
+Container *CourierSystem::findContainer(int containerID)
+{
+    int *index = containerIndex.get(containerID);
+    return index ? &containers[*index] : nullptr;
+}
+
+void CourierSystem::rebuildContainerIndex()
+{
+    containerIndex.clear();
+    parcelContainers.clear();
+    containerParents.clear();
+    for (int i = 0; i < containers.size(); i++)
+    {
+        containerIndex.insert(containers[i].containerID, i);
+        containers[i].children.clear();
+    }
+    for (int i = 0; i < containers.size(); i++)
+    {
+        Container &container = containers[i];
+        for (int j = 0; j < container.parcels.size(); j++)
+        {
+            ContainerSlot slot = {container.containerID, j};
+            parcelContainers.insert(container.parcels[j], slot);
+        }
+        Container *parent = findContainer(container.parentID);
+        if (!parent)
+        {
+            container.parentID = -1;
+            continue;
+        }
+        ContainerSlot slot = {parent->containerID, parent->children.size()};
+        parent->children.push_back(container.containerID);
+        containerParents.insert(container.containerID, slot);
+    }
+}
+
+void CourierSystem::unpackParcel(int trackingID)
+{
+    ContainerSlot *slot = parcelContainers.get(trackingID);
+    if (!slot)
+        return;
+
+    Vector<int> &parcels = findContainer(slot->containerID)->parcels;
+    int last = parcels.size() - 1;
+    if (slot->slot != last)
+    {
+        parcels[slot->slot] = parcels[last];
+        parcelContainers.get(parcels[last])->slot = slot->slot;
+    }
+    parcels.pop_back();
+    parcelContainers.remove(trackingID);
+}
+
+void CourierSystem::unnestContainer(int containerID)
+{
+    ContainerSlot *slot = containerParents.get(containerID);
+    if (!slot)
+        return;
+
+    Vector<int> &children = findContainer(slot->containerID)->children;
+    int last = children.size() - 1;
+    if (slot->slot != last)
+    {
+        children[slot->slot] = children[last];
+        containerParents.get(children[last])->slot = slot->slot;
+    }
+    children.pop_back();
+    containerParents.remove(containerID);
+    findContainer(containerID)->parentID = -1;
+}
+
+int CourierSystem::applyContainerEvent(const ContainerEvent &event)
+{
+    if (event.op == "CREATE")
+    {
+        if (findContainer(event.containerID))
+            return 0;
+        containers.push_back(Container(event.containerID, static_cast<ContainerType>(event.arg), event.cityID));
+        containerIndex.insert(event.containerID, containers.size() - 1);
+        if (event.containerID >= nextContainerID)
+            nextContainerID = event.containerID + 1;
+        return 0;
+    }
+
+    Container *container = findContainer(event.containerID);
+    if (!container)
+        return 0;
+
+    if (event.op == "PACK")
+    {
+        if (!findParcel(event.arg))
+            return 0;
+        unpackParcel(event.arg);
+        ContainerSlot slot = {container->containerID, container->parcels.size()};
+        container->parcels.push_back(event.arg);
+        parcelContainers.insert(event.arg, slot);
+        return 1;
+    }
+
+    if (event.op == "NEST")
+    {
+        Container *child = findContainer(event.arg);
+        if (!child)
+            return 0;
+        unnestContainer(child->containerID);
+        ContainerSlot slot = {container->containerID, container->children.size()};
+        container->children.push_back(child->containerID);
+        child->parentID = container->containerID;
+        containerParents.insert(child->containerID, slot);
+        return 1;
+    }
+
+    if (event.op == "EMPTY")
+    {
+        int released = container->parcels.size() + container->children.size();
+        for (int i = 0; i < container->parcels.size(); i++)
+        {
+            parcelContainers.remove(container->parcels[i]);
+        }
+        for (int i = 0; i < container->children.size(); i++)
+        {
+            containerParents.remove(container->children[i]);
+            findContainer(container->children[i])->parentID = -1;
+        }
+        container->parcels.clear();
+        container->children.clear();
+        return released;
+    }
+
+    bool loading = event.op == "LOAD";
+    if (!loading && event.op != "UNLOAD")
+        return 0;
+
+    City *city = cityMap.getNodeData(event.cityID);
+    string entry = event.timestamp + (loading ? " - Loaded at " : " - Unloaded at ") +
+                   (city ? city->name : to_string(event.cityID)) + " (" + container->getLabel() + ")";
+
+    int updated = 0;
+    Stack<int> pending;
+    pending.push(container->containerID);
+    while (!pending.empty())
+    {
+        Container *current = findContainer(pending.top());
+        pending.pop();
+        current->currentCityID = event.cityID;
+        for (int i = 0; i < current->children.size(); i++)
+        {
+            pending.push(current->children[i]);
+        }
+        for (int i = 0; i < current->parcels.size(); i++)
+        {
+            Parcel *parcel = findParcel(current->parcels[i]);
+            if (!parcel || parcel->status == Status::Delivered || parcel->status == Status::Returned)
+                continue;
+            parcel->currentCityID = event.cityID;
+            parcel->history.push_back(entry);
+            updated++;
+        }
+    }
+    return updated;
+}
+
+void CourierSystem::journalContainerEvents(const Vector<ContainerEvent> &events)
+{
+    CSVUtils::appendContainerJournal("container_journal.csv", events);
+}
+
+int CourierSystem::createContainer(ContainerType type, int cityID)
+{
+    if (type < ContainerType::Bag || type > ContainerType::Truck)
+    {
+        cout << "\n[ERROR] Invalid container type.\n";
+        return -1;
+    }
+    if (!validateCityID(cityID))
+    {
+        cout << "\n[ERROR] Invalid City ID: " << cityID << "\n";
+        return -1;
+    }
+
+    Vector<ContainerEvent> events;
+    events.push_back(ContainerEvent("CREATE", nextContainerID, static_cast<int>(type), cityID, getCurrentTimestamp()));
+    journalContainerEvents(events);
+    applyContainerEvent(events[0]);
+
+    Container *container = findContainer(events[0].containerID);
+    cout << "\n[SUCCESS] " << container->getLabel() << " created at " << cityMap.getNodeData(cityID)->name << ".\n";
+    return container->containerID;
+}
+
+void CourierSystem::packParcels(int containerID, const Vector<int> &trackingIDs)
+{
+    Container *container = findContainer(containerID);
+    if (!container)
+    {
+        cout << "\n[ERROR] Container ID " << containerID << " not found.\n";
+        return;
+    }
+
+    Vector<ContainerEvent> events;
+    string timestamp = getCurrentTimestamp();
+    int skipped = 0;
+    for (int i = 0; i < trackingIDs.size(); i++)
+    {
+        Parcel *parcel = findParcel(trackingIDs[i]);
+        if (!parcel || parcel->status == Status::Delivered || parcel->status == Status::Returned)
+        {
+            skipped++;
+            continue;
+        }
+        events.push_back(ContainerEvent("PACK", containerID, trackingIDs[i], -1, timestamp));
+    }
+    if (events.empty())
+    {
+        cout << "\n[ERROR] None of the parcels can be packed.\n";
+        return;
+    }
+
+    journalContainerEvents(events);
+    for (int i = 0; i < events.size(); i++)
+    {
+        applyContainerEvent(events[i]);
+    }
+
+    cout << "\n[SUCCESS] " << events.size() << " parcel(s) packed into " << container->getLabel() << ".";
+    if (skipped > 0)
+        cout << " " << skipped << " skipped (unknown, delivered or returned).";
+    cout << "\n";
+}
+
+void CourierSystem::nestContainer(int childID, int parentID)
+{
+    Container *child = findContainer(childID);
+    Container *parent = findContainer(parentID);
+    if (!child || !parent)
+    {
+        cout << "\n[ERROR] Container not found.\n";
+        return;
+    }
+    if (child->type >= parent->type)
+    {
+        cout << "\n[ERROR] A " << child->getTypeStr() << " cannot go inside a " << parent->getTypeStr() << ".\n";
+        return;
+    }
+
+    Vector<ContainerEvent> events;
+    events.push_back(ContainerEvent("NEST", parentID, childID, -1, getCurrentTimestamp()));
+    journalContainerEvents(events);
+    applyContainerEvent(events[0]);
+    cout << "\n[SUCCESS] " << child->getLabel() << " placed inside " << parent->getLabel() << ".\n";
+}
+
+void CourierSystem::emptyContainer(int containerID)
+{
+    Container *container = findContainer(containerID);
+    if (!container)
+    {
+        cout << "\n[ERROR] Container ID " << containerID << " not found.\n";
+        return;
+    }
+
+    Vector<ContainerEvent> events;
+    events.push_back(ContainerEvent("EMPTY", containerID, -1, -1, getCurrentTimestamp()));
+    journalContainerEvents(events);
+    int released = applyContainerEvent(events[0]);
+    cout << "\n[SUCCESS] " << container->getLabel() << " emptied; " << released << " item(s) released.\n";
+}
+
+void CourierSystem::scanContainer(int containerID, int cityID, bool loading)
+{
+    Container *container = findContainer(containerID);
+    if (!container)
+    {
+        cout << "\n[ERROR] Container ID " << containerID << " not found.\n";
+        return;
+    }
+    if (!validateCityID(cityID))
+    {
+        cout << "\n[ERROR] Invalid City ID: " << cityID << "\n";
+        return;
+    }
+    if (container->parentID != -1)
+        cout << "\n[WARNING] " << container->getLabel() << " is inside " << findContainer(container->parentID)->getLabel()
+             << "; scanning it on its own.\n";
+
+    clock_t started = clock();
+    Vector<ContainerEvent> events;
+    events.push_back(ContainerEvent(loading ? "LOAD" : "UNLOAD", containerID, -1, cityID, getCurrentTimestamp()));
+    journalContainerEvents(events);
+    int updated = applyContainerEvent(events[0]);
+    double elapsedMs = 1000.0 * (clock() - started) / CLOCKS_PER_SEC;
+
+    ostringstream timing;
+    timing << fixed << setprecision(2) << elapsedMs;
+    cout << "\n[SUCCESS] " << container->getLabel() << (loading ? " loaded at " : " unloaded at ")
+         << cityMap.getNodeData(cityID)->name << ": " << updated << " parcel(s) updated in " << timing.str() << " ms.\n";
+}
+
+void CourierSystem::displayContainers()
+{
+    if (containers.empty())
+    {
+        cout << "\n[INFO] No containers registered.\n";
+        return;
+    }
+
+    Vector<int> nestedParcels(containers.size(), 0);
+    Vector<int> nestedWeight(containers.size(), 0);
+    for (int i = 0; i < containers.size(); i++)
+    {
+        for (int j = 0; j < containers[i].parcels.size(); j++)
+        {
+            Parcel *parcel = findParcel(containers[i].parcels[j]);
+            nestedParcels[i]++;
+            nestedWeight[i] += parcel ? parcel->weight : 0;
+        }
+    }
+    Vector<int> order;
+    for (int i = 0; i < containers.size(); i++)
+    {
+        if (containers[i].parentID == -1)
+            order.push_back(i);
+    }
+    for (int k = 0; k < order.size(); k++)
+    {
+        Container &container = containers[order[k]];
+        for (int j = 0; j < container.children.size(); j++)
+        {
+            order.push_back(*containerIndex.get(container.children[j]));
+        }
+    }
+    for (int k = order.size() - 1; k >= 0; k--)
+    {
+        int parent = containers[order[k]].parentID;
+        if (parent == -1)
+            continue;
+        int p = *containerIndex.get(parent);
+        nestedParcels[p] += nestedParcels[order[k]];
+        nestedWeight[p] += nestedWeight[order[k]];
+    }
+
+    Table t;
+    t.addHeader("Container");
+    t.addHeader("Location");
+    t.addHeader("Inside");
+    t.addHeader("Parcels");
+    t.addHeader("Total Parcels");
+    t.addHeader("Weight (kg)");
+    for (int i = 0; i < containers.size(); i++)
+    {
+        Container &container = containers[i];
+        City *city = cityMap.getNodeData(container.currentCityID);
+        Container *parent = findContainer(container.parentID);
+        t.addRow({container.getLabel(),
+                  city ? city->name : to_string(container.currentCityID),
+                  parent ? parent->getLabel() : "-",
+                  to_string(container.parcels.size()),
+                  to_string(nestedParcels[i]),
+                  to_string(nestedWeight[i])});
+    }
+
+    cout << "\n=== Containers ===\n";
+    t.print();
+}
+
+void CourierSystem::displayContainerContents(int containerID)
+{
+    Container *root = findContainer(containerID);
+    if (!root)
+    {
+        cout << "\n[ERROR] Container ID " << containerID << " not found.\n";
+        return;
+    }
+
+    Table t;
+    t.addHeader("Tracking ID");
+    t.addHeader("Container");
+    t.addHeader("Status");
+    t.addHeader("Location");
+    t.addHeader("Destination");
+    Stack<int> pending;
+    pending.push(containerID);
+    while (!pending.empty())
+    {
+        Container *current = findContainer(pending.top());
+        pending.pop();
+        for (int i = 0; i < current->children.size(); i++)
+        {
+            pending.push(current->children[i]);
+        }
+        for (int i = 0; i < current->parcels.size(); i++)
+        {
+            Parcel *parcel = findParcel(current->parcels[i]);
+            if (!parcel)
+                continue;
+            City *location = cityMap.getNodeData(parcel->currentCityID);
+            City *dest = cityMap.getNodeData(parcel->destCityID);
+            t.addRow({to_string(parcel->trackingID), current->getLabel(), parcel->getStatusStr(),
+                      location ? location->name : to_string(parcel->currentCityID),
+                      dest ? dest->name : to_string(parcel->destCityID)});
+        }
+    }
+
+    cout << "\n=== Contents of " << root->getLabel() << " ===\n";
+    t.print();
+}
+
+void CourierSystem::recordDeliveryAttempt(int trackingID, bool success)
+{
+    Parcel *parcel = findParcel(trackingID);
+    if (!parcel)
+        return;
+
+    parcel->deliveryAttempts++;
+    if (success)
+    {
+        releaseParcelRoute(*parcel);
+        parcel->status = Status::Delivered;
+        parcel->history.push_back(getCurrentTimestamp() + " - Delivery successful (Attempt " + to_string(parcel->deliveryAttempts) + ")");
+    }
+    else
+    {
+        parcel->history.push_back(getCurrentTimestamp() + " - Delivery attempt failed (Attempt " + to_string(parcel->deliveryAttempts) + ")");
+        if (parcel->deliveryAttempts >= 3)
+        {
+            returnToSender(trackingID);
+        }
+    }
+}
+
+void CourierSystem::returnToSender(int trackingID)
+{
+    Parcel *parcel = findParcel(trackingID);
+    if (!parcel)
+    {
+        cout << "\n[ERROR] Parcel ID " << trackingID << " not found.\n";
+        return;
+    }
+
+    if (parcel->status == Status::Delivered)
+    {
+        cout << "\n[ERROR] Cannot return delivered parcel to sender.\n";
+        return;
+    }
+
+    string prevState = parcel->getStatusStr();
+    releaseParcelRoute(*parcel);
+    parcel->status = Status::Returned;
+
+    removeParcelFromQueue(transitQueue, trackingID);
+
+    parcel->history.push_back(getCurrentTimestamp() + " - Returned to sender after " + to_string(parcel->deliveryAttempts) + " failed attempts");
+
+    Rider *rider = detachParcel(trackingID);
+    if (rider)
+    {
+        rider->currentLoad -= parcel->weight;
+        touchRider(*rider);
+    }
+
+    saveData();
+    logOperation(OperationType::ReturnToSender, trackingID, prevState, "Returned", -1);
+    cout << "\n[SUCCESS] Parcel " << trackingID << " returned to sender.\n";
+}
+
+void CourierSystem::addRider(string name, int capacity, int cityID)
+{
+    Rider newRider(nextRiderID++, name, capacity, cityID);
+    riders.push_back(newRider);
+    riderIndex.insert(newRider.riderID, riders.size() - 1);
+    riderStamp.push_back(0);
+    touchRider(newRider);
+
+    CSVUtils::saveRider("riders.csv", newRider.riderID, name, capacity, cityID);
+
+    cout << "\n[SUCCESS] Rider '" << name << "' added with ID: " << newRider.riderID << "\n";
+}
+
+void CourierSystem::displayRiders()
 {
+    drainLocationUpdates();
+    syncShiftClock();
+    Table t;
+    t.addHeader("Rider ID");
+    t.addHeader("Name");
+    t.addHeader("Capacity (kg)");
+    t.addHeader("Current Load (kg)");
+    t.addHeader("Available (kg)");
+    t.addHeader("Location");
 
-    for (int i = 0; i < parcels.size(); i++)
+    for (int i = 0; i < riders.size(); i++)
     {
-        for (int j = 0; j < parcels.size() - i - 1; j++)
-        {
-            if (parcels[j].destCityID > parcels[j + 1].destCityID)
-            {
-                Parcel temp = parcels[j];
-                parcels[j] = parcels[j + 1];
-                parcels[j + 1] = temp;
-            }
-        }
+        City *city = cityMap.getNodeData(riders[i].currentCityID);
+        string cityName = city ? city->name : to_string(riders[i].currentCityID);
+        t.addRow({to_string(riders[i].riderID),
+                  riders[i].name,
+                  to_string(riders[i].capacity),
+                  to_string(riders[i].currentLoad),
+                  to_string(riders[i].getAvailableCapacity()),
+                  cityName});
     }
+
+    cout << "\n=== All Riders ===\n";
+    t.print();
 }
 
-void CourierSystem::displayParcelsByWeight()
+void CourierSystem::displayRiderLoad(int riderID)
 {
+    Rider *rider = findRider(riderID);
+    if (!rider)
+    {
+        cout << "\n[ERROR] Rider not found.\n";
+        return;
+    }
+
     Table t;
-    t.addHeader("Tracking ID");
+    t.addHeader("Parcel ID");
     t.addHeader("Weight (kg)");
-    t.addHeader("Category");
-    t.addHeader("Priority");
     t.addHeader("Status");
 
-    Vector<Parcel> sorted = allParcels;
-    sortParcelsByWeight(sorted);
-
-    for (int i = 0; i < sorted.size(); i++)
+    for (int j = 0; j < rider->assignedParcels.size(); j++)
     {
-        t.addRow({to_string(sorted[i].trackingID),
-                  to_string(sorted[i].weight),
-                  sorted[i].getWeightCategoryStr(),
-                  sorted[i].getPriorityStr(),
-                  sorted[i].getStatusStr()});
+        Parcel *parcel = findParcel(rider->assignedParcels[j]);
+        if (parcel)
+        {
+            t.addRow({to_string(parcel->trackingID),
+                      to_string(parcel->weight),
+                      parcel->getStatusStr()});
+        }
     }
 
-    cout << "\n=== Parcels Sorted by Weight ===\n";
+    cout << "\n=== Rider " << rider->name << " Load ===\n";
+    cout << "Total Capacity: " << rider->capacity << " kg\n";
+    cout << "Current Load: " << rider->currentLoad << " kg\n";
+    cout << "Available: " << rider->getAvailableCapacity() << " kg\n";
     t.print();
 }
 
-void CourierSystem::displayParcelsByDestination()
+void CourierSystem::displayAllRiderLoads()
 {
-    Table t;
-    t.setHeaderColor(BRIGHT_BLUE BOLD);
-    t.setBorderColor(CYAN);
-    t.setRowColor(WHITE);
-    t.addHeader("Tracking ID");
-    t.addHeader("Destination City");
-    t.addHeader("Priority");
-    t.addHeader("Status");
+    for (int i = 0; i < riders.size(); i++)
+    {
+        displayRiderLoad(riders[i].riderID);
+    }
+}
 
-    Vector<Parcel> sorted = allParcels;
-    sortParcelsByDestination(sorted);
+void CourierSystem::displayNearestRiders(int cityID, int requiredCapacity, int k)
+{
+    if (!validateCityID(cityID))
+    {
+        cout << "\n[ERROR] Invalid city ID.\n";
+        return;
+    }
 
-    for (int i = 0; i < sorted.size(); i++)
+    Vector<RiderMatch> matches;
+    if (findNearestRiders(cityID, requiredCapacity, k, matches) == 0)
     {
-        City *dest = cityMap.getNodeData(sorted[i].destCityID);
-        string destName = dest ? dest->name : to_string(sorted[i].destCityID);
-        t.addRow({to_string(sorted[i].trackingID),
-                  destName,
-                  sorted[i].getPriorityStr(),
-                  sorted[i].getStatusStr()});
+        cout << "\n[INFO] No rider with " << requiredCapacity << " kg free can reach this city over open routes.\n";
+        return;
     }
 
-    int titleWidth = 45;
-    int totalWidth = titleWidth + 2;
-    cout << BRIGHT_BLUE BOLD;
-    cout << "\n";
-    cout << "┏";
-    for (int i = 0; i < totalWidth - 2; i++)
-        cout << "━";
-    cout << "┓\n";
-    cout << "┃";
-    int titleLen = 43;
-    int padding = (totalWidth - titleLen) / 2;
-    for (int i = 0; i < padding; i++)
-        cout << " ";
-    cout << "   Parcels Sorted by Destination   ";
-    for (int i = 0; i < padding - 1; i++)
-        cout << " ";
-    cout << "┃\n";
-    cout << "┗";
-    for (int i = 0; i < totalWidth - 2; i++)
-        cout << "━";
-    cout << "┛\n"
-         << RESET;
+    Table t;
+    t.addHeader("Rider ID");
+    t.addHeader("Name");
+    t.addHeader("Location");
+    t.addHeader("Available (kg)");
+    t.addHeader("Road Distance");
+
+    for (int i = 0; i < matches.size(); i++)
+    {
+        Rider *rider = findRider(matches[i].riderID);
+        City *city = cityMap.getNodeData(matches[i].cityID);
+        t.addRow({to_string(rider->riderID),
+                  rider->name,
+                  city ? city->name : to_string(matches[i].cityID),
+                  to_string(rider->getAvailableCapacity()),
+                  to_string(matches[i].distance)});
+    }
+
+    City *pickup = cityMap.getNodeData(cityID);
+    cout << "\n=== Nearest Riders to " << (pickup ? pickup->name : to_string(cityID)) << " ===\n";
     t.print();
 }
 
-void CourierSystem::sortParcelsByPriority(Vector<Parcel> &parcels)
+long long CourierSystem::tourCost(const Vector<Vector<int>> &matrix, const Vector<int> &node, const Vector<int> &order)
 {
+    long long cost = 0;
+    for (int k = 0; k + 1 < order.size(); k++)
+    {
+        cost += matrix[node[order[k]]][node[order[k + 1]]];
+    }
+    return cost;
+}
 
-    for (int i = 0; i < parcels.size(); i++)
+bool CourierSystem::tourFeasible(const Vector<int> &pickupOf, const Vector<int> &order, Vector<int> &position)
+{
+    for (int k = 0; k < order.size(); k++)
     {
-        for (int j = 0; j < parcels.size() - i - 1; j++)
+        position[order[k]] = k;
+    }
+    for (int stop = 0; stop < pickupOf.size(); stop++)
+    {
+        if (pickupOf[stop] != -1 && position[pickupOf[stop]] > position[stop])
+            return false;
+    }
+    return true;
+}
+
+void CourierSystem::sequenceTour(const Vector<Vector<int>> &matrix, const Vector<int> &node, const Vector<int> &pickupOf,
+                                 Vector<int> &order, int budgetMs)
+{
+    chrono::steady_clock::time_point deadline = chrono::steady_clock::now() + chrono::milliseconds(budgetMs);
+    int s = node.size();
+    Vector<bool> visited(s, false);
+    Vector<int> position(s, 0);
+
+    order.clear();
+    order.push_back(0);
+    visited[0] = true;
+    while (order.size() < s)
+    {
+        int from = node[order[order.size() - 1]];
+        int next = -1;
+        for (int stop = 1; stop < s; stop++)
         {
-            if (parcels[j].priority > parcels[j + 1].priority)
+            if (visited[stop] || (pickupOf[stop] != -1 && !visited[pickupOf[stop]]))
+                continue;
+            if (next == -1 || matrix[from][node[stop]] < matrix[from][node[next]])
+                next = stop;
+        }
+        visited[next] = true;
+        order.push_back(next);
+    }
+
+    auto improve = [&](Vector<int> &tour, long long &best)
+    {
+        bool improved = true;
+        while (improved && chrono::steady_clock::now() < deadline)
+        {
+            improved = false;
+
+            for (int i = 1; i + 1 < s; i++)
             {
-                Parcel temp = parcels[j];
-                parcels[j] = parcels[j + 1];
-                parcels[j + 1] = temp;
+                for (int j = i + 1; j < s; j++)
+                {
+                    Vector<int> candidate = tour;
+                    for (int a = i, b = j; a < b; a++, b--)
+                    {
+                        swap(candidate[a], candidate[b]);
+                    }
+                    if (!tourFeasible(pickupOf, candidate, position))
+                        continue;
+                    long long cost = tourCost(matrix, node, candidate);
+                    if (cost < best)
+                    {
+                        tour = candidate;
+                        best = cost;
+                        improved = true;
+                    }
+                }
+                if (chrono::steady_clock::now() >= deadline)
+                    return;
+            }
+
+            for (int len = 1; len <= 3; len++)
+            {
+                for (int i = 1; i + len <= s; i++)
+                {
+                    Vector<int> rest;
+                    for (int k = 0; k < s; k++)
+                    {
+                        if (k < i || k >= i + len)
+                            rest.push_back(tour[k]);
+                    }
+                    for (int at = 1; at <= rest.size(); at++)
+                    {
+                        if (at == i)
+                            continue;
+                        Vector<int> candidate;
+                        for (int k = 0; k < at; k++)
+                        {
+                            candidate.push_back(rest[k]);
+                        }
+                        for (int k = i; k < i + len; k++)
+                        {
+                            candidate.push_back(tour[k]);
+                        }
+                        for (int k = at; k < rest.size(); k++)
+                        {
+                            candidate.push_back(rest[k]);
+                        }
+                        if (!tourFeasible(pickupOf, candidate, position))
+                            continue;
+                        long long cost = tourCost(matrix, node, candidate);
+                        if (cost < best)
+                        {
+                            tour = candidate;
+                            best = cost;
+                            improved = true;
+                            break;
+                        }
+                    }
+                    if (chrono::steady_clock::now() >= deadline)
+                        return;
+                }
             }
         }
-    }
-}
+    };
 
-void CourierSystem::displayParcelsByPriority()
-{
-    Table t;
-    t.setHeaderColor(BRIGHT_GREEN BOLD);
-    t.setBorderColor(GREEN);
-    t.setRowColor(WHITE);
-    t.addHeader("Tracking ID");
-    t.addHeader("Priority");
-    t.addHeader("Weight (kg)");
-    t.addHeader("Status");
-    t.addHeader("Fragile");
+    long long best = tourCost(matrix, node, order);
+    improve(order, best);
 
-    Vector<Parcel> sorted = allParcels;
-    sortParcelsByPriority(sorted);
+    unsigned int seed = 2654435761u * s;
+    auto nextRandom = [&](int bound)
+    {
+        seed = seed * 1103515245u + 12345u;
+        return static_cast<int>((seed >> 8) % bound);
+    };
 
-    for (int i = 0; i < sorted.size(); i++)
+    int stale = 0;
+    while (s > 3 && stale < s * s && chrono::steady_clock::now() < deadline)
     {
-        t.addRow({to_string(sorted[i].trackingID),
-                  sorted[i].getPriorityStr(),
-                  to_string(sorted[i].weight),
-                  sorted[i].getStatusStr(),
-                  sorted[i].isFragile ? "Yes" : "No"});
-    }
+        Vector<int> trial = order;
+        for (int kick = 0; kick < 3; kick++)
+        {
+            int from = 1 + nextRandom(s - 1);
+            int to = 1 + nextRandom(s - 1);
+            int moved = trial[from];
+            Vector<int> shifted;
+            for (int k = 0; k < s; k++)
+            {
+                if (k != from)
+                    shifted.push_back(trial[k]);
+            }
+            Vector<int> candidate;
+            for (int k = 0; k < shifted.size(); k++)
+            {
+                if (k == to)
+                    candidate.push_back(moved);
+                candidate.push_back(shifted[k]);
+            }
+            if (to >= shifted.size())
+                candidate.push_back(moved);
+            if (tourFeasible(pickupOf, candidate, position))
+                trial = candidate;
+        }
 
-    int titleWidth = 45;
-    int totalWidth = titleWidth + 2;
-    cout << BRIGHT_GREEN BOLD;
-    cout << "\n";
-    cout << "┏";
-    for (int i = 0; i < totalWidth - 2; i++)
-        cout << "━";
-    cout << "┓\n";
-    cout << "┃";
-    int titleLen = 43;
-    int padding = (totalWidth - titleLen) / 2;
-    for (int i = 0; i < padding; i++)
-        cout << " ";
-    cout << "   Parcels Sorted by Priority   ";
-    for (int i = 0; i < padding - 1; i++)
-        cout << " ";
-    cout << "┃\n";
-    cout << "┗";
-    for (int i = 0; i < totalWidth - 2; i++)
-        cout << "━";
-    cout << "┛\n"
-         << RESET;
-    t.print();
+        long long cost = tourCost(matrix, node, trial);
+        improve(trial, cost);
+        if (cost < best)
+        {
+            order = trial;
+            best = cost;
+            stale = 0;
+        }
+        else
+        {
+            stale++;
+        }
+    }
 }
 
-Vector<Parcel> CourierSystem::getFragileParcels()
+bool CourierSystem::buildRiderTour(const Rider &rider, RiderTour &tour, int budgetMs)
 {
-    Vector<Parcel> result;
-    for (int i = 0; i < allParcels.size(); i++)
+    Vector<TourStop> stops;
+    Vector<int> pickupOf;
+    TourStop start = {rider.currentCityID, -1, false};
+    stops.push_back(start);
+    pickupOf.push_back(-1);
+    for (int i = 0; i < rider.assignedParcels.size(); i++)
+    {
+        Parcel *parcel = findParcel(rider.assignedParcels[i]);
+        if (!parcel || parcel->status != Status::InTransit)
+            continue;
+        TourStop pickup = {parcel->currentCityID, parcel->trackingID, false};
+        TourStop drop = {parcel->destCityID, parcel->trackingID, true};
+        stops.push_back(pickup);
+        pickupOf.push_back(-1);
+        stops.push_back(drop);
+        pickupOf.push_back(stops.size() - 2);
+    }
+
+    HashTable<int, int> nodeOf;
+    Vector<int> node;
+    Vector<int> roots;
+    for (int i = 0; i < stops.size(); i++)
     {
-        if (allParcels[i].isFragile)
+        int *existing = nodeOf.get(stops[i].cityID);
+        if (!existing)
         {
-            result.push_back(allParcels[i]);
+            int root = connectivityIndexOf(stops[i].cityID);
+            if (root == -1)
+                return false;
+            nodeOf.insert(stops[i].cityID, roots.size());
+            roots.push_back(root);
+            existing = nodeOf.get(stops[i].cityID);
         }
+        node.push_back(*existing);
     }
-    return result;
-}
 
-void CourierSystem::markParcelAsFragile(int trackingID)
-{
-    Parcel *parcel = findParcel(trackingID);
-    if (!parcel)
+    Vector<Vector<int>> matrix;
+    Vector<Vector<int>> parents;
+    for (int a = 0; a < roots.size(); a++)
     {
-        cout << "\n[ERROR] Parcel ID not found.\n";
-        return;
+        Vector<int> dist, parent, row;
+        snapshotTree(serviceSnapshot, roots[a], false, dist, parent);
+        for (int b = 0; b < roots.size(); b++)
+        {
+            if (dist[roots[b]] == 2147483647)
+                return false;
+            row.push_back(dist[roots[b]]);
+        }
+        matrix.push_back(row);
+        parents.push_back(parent);
     }
 
-    parcel->isFragile = true;
-    parcel->history.push_back(getCurrentTimestamp() + " - Marked as Fragile");
+    Vector<int> sequential;
+    for (int i = 0; i < stops.size(); i++)
+    {
+        sequential.push_back(i);
+    }
+    Vector<int> order;
+    sequenceTour(matrix, node, pickupOf, order, budgetMs);
 
-    if (parcel->status == Status::InWarehouse)
+    tour.stops.clear();
+    tour.stopAt.clear();
+    tour.path.clear();
+    tour.distance = tourCost(matrix, node, order);
+    tour.sequentialDistance = tourCost(matrix, node, sequential);
+    tour.path.push_back(serviceSnapshot.cityIDs[roots[node[order[0]]]]);
+    for (int k = 0; k < order.size(); k++)
     {
-        warehouseQueue.remove(*parcel);
-        warehouseQueue.push(*parcel);
+        if (k > 0)
+        {
+            const Vector<int> &parent = parents[node[order[k - 1]]];
+            Vector<int> leg;
+            for (int v = roots[node[order[k]]]; v != roots[node[order[k - 1]]]; v = parent[v])
+            {
+                leg.push_back(serviceSnapshot.cityIDs[v]);
+            }
+            for (int i = leg.size() - 1; i >= 0; i--)
+            {
+                tour.path.push_back(leg[i]);
+            }
+        }
+        tour.stops.push_back(stops[order[k]]);
+        tour.stopAt.push_back(tour.path.size() - 1);
     }
+    return true;
+}
 
-    saveData();
-    cout << "\n[SUCCESS] Parcel " << trackingID << " marked as fragile.\n";
+void CourierSystem::discardRiderTour(int trackingID)
+{
+    ParcelCarrier *carrier = parcelCarriers.get(trackingID);
+    if (carrier)
+        riderTours.remove(carrier->riderID);
 }
 
-void CourierSystem::processNextParcel()
+void CourierSystem::planRiderTours(int budgetMs)
 {
-    if (pickupQueue.empty())
+    if (budgetMs < 1)
+        budgetMs = 1;
+    drainLocationUpdates();
+    syncServiceAreaCache();
+
+    Vector<int> fleet;
+    for (int i = 0; i < riders.size(); i++)
     {
-        cout << "\n[INFO] No pending parcels to process.\n";
+        riderTours.remove(riders[i].riderID);
+        if (riders[i].assignedParcels.size() > 1)
+            fleet.push_back(i);
+    }
+    if (fleet.empty())
+    {
+        cout << "\n[INFO] No rider is carrying more than one parcel.\n";
         return;
     }
 
-    Parcel top = pickupQueue.front();
-    pickupQueue.pop();
+    Vector<RiderTour> tours(fleet.size(), RiderTour());
+    Vector<bool> planned(fleet.size(), false);
 
-    Parcel *parcel = findParcel(top.trackingID);
-    if (!parcel)
-        return;
+    int threadCount = static_cast<int>(thread::hardware_concurrency());
+    if (threadCount < 1)
+        threadCount = 1;
+    if (threadCount > fleet.size())
+        threadCount = fleet.size();
 
-    string prevState = parcel->getStatusStr();
-    parcel->status = Status::InWarehouse;
-    parcel->history.push_back(getCurrentTimestamp() + " - Processed at Warehouse");
+    atomic<int> nextRider(0);
+    auto worker = [&]()
+    {
+        for (int i = nextRider++; i < fleet.size(); i = nextRider++)
+        {
+            planned[i] = buildRiderTour(riders[fleet[i]], tours[i], budgetMs);
+        }
+    };
 
-    warehouseQueue.push(*parcel);
+    Vector<thread *> workers;
+    for (int t = 0; t < threadCount; t++)
+    {
+        workers.push_back(new thread(worker));
+    }
+    for (int t = 0; t < workers.size(); t++)
+    {
+        workers[t]->join();
+        delete workers[t];
+    }
 
-    saveData();
+    Table t;
+    t.addHeader("Rider");
+    t.addHeader("Stops");
+    t.addHeader("Sequential");
+    t.addHeader("Tour");
+    t.addHeader("Saved");
 
-    logOperation(OperationType::ProcessParcel, top.trackingID, prevState, "In Warehouse", -1);
-    cout << "\n[SUCCESS] Parcel " << top.trackingID << " (" << top.getPriorityStr() << ") moved to Warehouse.\n";
+    int skipped = 0;
+    for (int i = 0; i < fleet.size(); i++)
+    {
+        Rider &rider = riders[fleet[i]];
+        if (!planned[i])
+        {
+            skipped++;
+            continue;
+        }
+
+        RiderTour &tour = tours[i];
+        for (int k = 0; k < tour.stops.size(); k++)
+        {
+            if (!tour.stops[k].drop || tour.stops[k].trackingID == -1)
+                continue;
+            int from = 0;
+            while (tour.stops[from].trackingID != tour.stops[k].trackingID)
+            {
+                from++;
+            }
+            Vector<int> route;
+            for (int j = tour.stopAt[from]; j <= tour.stopAt[k]; j++)
+            {
+                route.push_back(tour.path[j]);
+            }
+            setParcelRoute(*findParcel(tour.stops[k].trackingID), route);
+            if (trafficAssignmentEnabled)
+                trafficAssigned.insert(tour.stops[k].trackingID, graphVersion);
+        }
+        riderTours.insert(rider.riderID, tour);
+
+        ostringstream saved;
+        saved << fixed << setprecision(1)
+              << (tour.sequentialDistance > 0 ? 100.0 * (tour.sequentialDistance - tour.distance) / tour.sequentialDistance : 0.0) << "%";
+        t.addRow({rider.name, to_string(tour.stops.size() - 1), to_string(tour.sequentialDistance),
+                  to_string(tour.distance), saved.str()});
+    }
+
+    cout << "\n=== Rider Tours (" << fleet.size() << " rider(s), " << threadCount << " thread(s)) ===\n";
+    t.print();
+    if (skipped > 0)
+        cout << "\n[WARNING] " << skipped << " rider(s) have a stop that is unreachable over open routes; their parcel routes were left unchanged.\n";
 }
 
-void CourierSystem::processParcelByID(int parcelID)
+void CourierSystem::displayRiderTour(int riderID)
 {
-    Parcel *parcel = findParcel(parcelID);
-    if (!parcel)
+    Rider *rider = findRider(riderID);
+    if (!rider)
     {
-        cout << "\n[ERROR] Parcel ID not found.\n";
+        cout << "\n[ERROR] Rider not found.\n";
         return;
     }
-
-    if (parcel->status != Status::Pending)
+    RiderTour *tour = riderTours.get(riderID);
+    if (!tour)
     {
-        cout << "\n[ERROR] Parcel is not in Pending status. Current status: " << parcel->getStatusStr() << "\n";
+        cout << "\n[INFO] No tour planned for " << rider->name << ". Plan tours first.\n";
         return;
     }
 
-    if (!pickupQueue.remove(*parcel))
+    Table t;
+    t.addHeader("Stop");
+    t.addHeader("City");
+    t.addHeader("Action");
+
+    for (int k = 0; k < tour->stops.size(); k++)
     {
-        cout << "\n[WARNING] Parcel not found in pickup queue, but proceeding...\n";
+        City *city = cityMap.getNodeData(tour->stops[k].cityID);
+        string action = "Start";
+        if (tour->stops[k].trackingID != -1)
+            action = (tour->stops[k].drop ? "Deliver " : "Pick up ") + to_string(tour->stops[k].trackingID);
+        t.addRow({to_string(k), city ? city->name : to_string(tour->stops[k].cityID), action});
     }
 
-    string prevState = parcel->getStatusStr();
-    parcel->status = Status::InWarehouse;
-    parcel->history.push_back(getCurrentTimestamp() + " - Processed at Warehouse");
-
-    warehouseQueue.push(*parcel);
-
-    saveData();
+    cout << "\n=== Tour for " << rider->name << " (" << tour->distance << " km) ===\n";
+    t.print();
 
-    logOperation(OperationType::ProcessParcel, parcelID, prevState, "In Warehouse", -1);
-    cout << "\n[SUCCESS] Parcel " << parcelID << " (" << parcel->getPriorityStr() << ") moved to Warehouse.\n";
+    cout << "Path: ";
+    for (int i = 0; i < tour->path.size(); i++)
+    {
+        City *city = cityMap.getNodeData(tour->path[i]);
+        cout << (city ? city->name : to_string(tour->path[i]));
+        if (i + 1 < tour->path.size())
+            cout << " -> ";
+    }
+    cout << "\n";
 }
 
-void CourierSystem::assignRider()
+void CourierSystem::planFleetRebalancing()
 {
-    if (warehouseQueue.empty())
+    clock_t started = clock();
+    drainLocationUpdates();
+    syncShiftClock();
+    syncServiceAreaCache();
+    const RoadSnapshot &roads = serviceSnapshot;
+    int n = roads.cityIDs.size();
+
+    Vector<Vector<int>> idle(n, Vector<int>());
+    Vector<int> backlogKg(n, 0);
+    long long idleCapacity = 0;
+    int idleCount = 0;
+    for (int i = 0; i < riders.size(); i++)
     {
-        cout << "\n[INFO] No parcels waiting in Warehouse.\n";
-        return;
+        int city = connectivityIndexOf(riders[i].currentCityID);
+        if (city == -1 || !riders[i].assignedParcels.empty() || !isRiderOnShift(riders[i].riderID, shiftClockMinute))
+            continue;
+        idle[city].push_back(i);
+        idleCapacity += riders[i].capacity;
+        idleCount++;
+    }
+    for (int i = 0; i < allParcels.size(); i++)
+    {
+        if (allParcels[i].status != Status::Pending && allParcels[i].status != Status::InWarehouse)
+            continue;
+        int city = connectivityIndexOf(allParcels[i].currentCityID);
+        if (city != -1)
+            backlogKg[city] += allParcels[i].weight;
     }
 
-    Parcel top = warehouseQueue.top();
-    warehouseQueue.pop();
-
-    Parcel *parcel = findParcel(top.trackingID);
-    if (!parcel)
-        return;
-
-    int riderID = findAvailableRider(parcel->weight, parcel->sourceCityID);
-    if (riderID == -1)
+    relocationOrders.clear();
+    if (idleCount == 0)
     {
-        cout << "\n[WARNING] No available rider found. Parcel remains in warehouse.\n";
-        warehouseQueue.push(*parcel);
+        cout << "\n[INFO] No idle riders to rebalance.\n";
         return;
     }
 
-    if (parcel->isFragile)
+    long long perRider = idleCapacity / idleCount;
+    if (perRider < 1)
+        perRider = 1;
+
+    Vector<int> surplusCity, surplus, deficitCity, deficit;
+    for (int c = 0; c < n; c++)
     {
-        Rider *rider = nullptr;
-        for (int i = 0; i < riders.size(); i++)
+        int needed = static_cast<int>((backlogKg[c] + perRider - 1) / perRider);
+        if (idle[c].size() > needed)
         {
-            if (riders[i].riderID == riderID)
-            {
-                rider = &riders[i];
-                break;
-            }
+            surplusCity.push_back(c);
+            surplus.push_back(idle[c].size() - needed);
         }
-        if (rider && rider->currentLoad > rider->capacity * 0.8)
+        else if (idle[c].size() < needed)
         {
-            cout << "\n[INFO] Fragile parcel assigned to rider with sufficient capacity buffer.\n";
+            deficitCity.push_back(c);
+            deficit.push_back(needed - idle[c].size());
         }
     }
-
-    assignRiderToParcel(parcel->trackingID, riderID);
-}
-
-void CourierSystem::assignRiderToParcel(int parcelID, int riderID)
-{
-    Parcel *parcel = findParcel(parcelID);
-    if (!parcel)
+    if (surplusCity.empty() || deficitCity.empty())
     {
-        cout << "\n[ERROR] Parcel not found.\n";
+        cout << "\n[INFO] Idle riders already match the pickup backlog. No relocation needed.\n";
         return;
     }
 
-    Rider *rider = nullptr;
-    for (int i = 0; i < riders.size(); i++)
+    int source = 0, sink = 1;
+    int firstDeficit = 2 + surplusCity.size();
+    MinCostFlow network(firstDeficit + deficitCity.size());
+    for (int i = 0; i < surplusCity.size(); i++)
     {
-        if (riders[i].riderID == riderID)
-        {
-            rider = &riders[i];
-            break;
-        }
+        network.addEdge(source, 2 + i, surplus[i], 0);
     }
-
-    if (!rider)
+    for (int j = 0; j < deficitCity.size(); j++)
     {
-        cout << "\n[ERROR] Rider not found.\n";
-        return;
+        network.addEdge(firstDeficit + j, sink, deficit[j], 0);
     }
 
-    if (!rider->canCarry(parcel->weight))
+    Vector<int> lanes, laneFrom, laneTo, laneDistance;
+    for (int i = 0; i < surplusCity.size(); i++)
     {
-        cout << "\n[ERROR] Rider capacity exceeded. Cannot assign parcel.\n";
-        return;
+        Vector<int> dist, parent;
+        snapshotTree(roads, surplusCity[i], false, dist, parent);
+        for (int j = 0; j < deficitCity.size(); j++)
+        {
+            int d = dist[deficitCity[j]];
+            if (d == 2147483647)
+                continue;
+            lanes.push_back(network.addEdge(2 + i, firstDeficit + j, surplus[i], d));
+            laneFrom.push_back(i);
+            laneTo.push_back(j);
+            laneDistance.push_back(d);
+        }
     }
 
-    string prevState = parcel->getStatusStr();
-    parcel->status = Status::InTransit;
+    int moved = 0;
+    long long totalDistance = network.solve(source, sink, moved);
 
-    Vector<int> route;
-    int dist = calculateShortestPath(parcel->sourceCityID, parcel->destCityID, route, true);
-    if (dist != -1)
+    for (int c = 0; c < surplusCity.size(); c++)
     {
-        parcel->currentRoute = route;
-        parcel->currentCityID = parcel->sourceCityID;
+        Vector<int> &pool = idle[surplusCity[c]];
+        auto largerFirst = [&](int a, int b) -> bool
+        {
+            if (riders[a].capacity != riders[b].capacity)
+                return riders[a].capacity < riders[b].capacity;
+            return riders[a].riderID > riders[b].riderID;
+        };
+        sort(pool.begin(), pool.end(), largerFirst);
     }
+    for (int l = 0; l < lanes.size(); l++)
+    {
+        Vector<int> &pool = idle[surplusCity[laneFrom[l]]];
+        for (int f = network.flowOn(lanes[l]); f > 0; f--)
+        {
+            Rider &rider = riders[pool[pool.size() - 1]];
+            pool.pop_back();
+            relocationOrders.push_back(RelocationOrder(rider.riderID, rider.currentCityID,
+                                                       roads.cityIDs[deficitCity[laneTo[l]]], laneDistance[l]));
+        }
+    }
+    double elapsedMs = 1000.0 * (clock() - started) / CLOCKS_PER_SEC;
 
-    parcel->history.push_back(getCurrentTimestamp() + " - Assigned to Rider " + rider->name);
-
-    rider->currentLoad += parcel->weight;
-    rider->assignedParcels.push_back(parcelID);
-
-    transitQueue.push(*parcel);
-
-    saveData();
+    int shortfall = -moved;
+    for (int j = 0; j < deficit.size(); j++)
+    {
+        shortfall += deficit[j];
+    }
 
-    logOperation(OperationType::AssignRider, parcelID, prevState, "In Transit", riderID);
-    cout << "\n[SUCCESS] Parcel " << parcelID << " assigned to Rider " << rider->name << ".\n";
+    Table t;
+    t.addHeader("Rider");
+    t.addHeader("From");
+    t.addHeader("To");
+    t.addHeader("Distance");
+    for (int i = 0; i < relocationOrders.size(); i++)
+    {
+        Rider *rider = findRider(relocationOrders[i].riderID);
+        City *from = cityMap.getNodeData(relocationOrders[i].fromCityID);
+        City *to = cityMap.getNodeData(relocationOrders[i].toCityID);
+        t.addRow({rider->name,
+                  from ? from->name : to_string(relocationOrders[i].fromCityID),
+                  to ? to->name : to_string(relocationOrders[i].toCityID),
+                  to_string(relocationOrders[i].distance)});
+    }
+
+    CSVUtils::saveRelocationOrders("relocation_orders.csv", relocationOrders);
+
+    ostringstream timing;
+    timing << fixed << setprecision(1) << elapsedMs;
+    cout << "\n=== Fleet Rebalancing (" << idleCount << " idle rider(s), " << surplusCity.size() << " surplus / "
+         << deficitCity.size() << " deficit cities) ===\n";
+    t.print();
+    cout << "\n[SUCCESS] " << moved << " relocation order(s), " << totalDistance << " km in total, planned in "
+         << timing.str() << " ms. Written to relocation_orders.csv.\n";
+    if (shortfall > 0)
+        cout << "[WARNING] " << shortfall << " rider slot(s) in deficit cities could not be filled over open routes.\n";
 }
 
-int CourierSystem::findAvailableRider(int requiredCapacity, int cityID)
+void CourierSystem::applyRelocationOrders()
 {
-    int bestRider = -1;
-    int bestAvailableCapacity = -1;
-    int bestDistance = -1;
+    if (relocationOrders.empty())
+    {
+        cout << "\n[INFO] No relocation orders pending. Plan a rebalancing first.\n";
+        return;
+    }
 
-    for (int i = 0; i < riders.size(); i++)
+    int applied = 0, stale = 0;
+    for (int i = 0; i < relocationOrders.size(); i++)
     {
-        if (riders[i].currentCityID == cityID && riders[i].canCarry(requiredCapacity))
+        Rider *rider = findRider(relocationOrders[i].riderID);
+        if (!rider || rider->currentCityID != relocationOrders[i].fromCityID || !rider->assignedParcels.empty())
         {
-            int available = riders[i].getAvailableCapacity();
-            if (bestRider == -1 || available > bestAvailableCapacity)
-            {
-                bestRider = riders[i].riderID;
-                bestAvailableCapacity = available;
-                bestDistance = 0;
-            }
+            stale++;
+            continue;
         }
+        rider->currentCityID = relocationOrders[i].toCityID;
+        touchRider(*rider);
+        applied++;
     }
+    relocationOrders.clear();
+
+    if (applied > 0)
+        saveData();
+    cout << "\n[SUCCESS] " << applied << " rider(s) relocated.";
+    if (stale > 0)
+        cout << " " << stale << " order(s) skipped because the rider has moved or picked up work since planning.";
+    cout << "\n";
+}
+
+void CourierSystem::readLocationFeed()
+{
+    ifstream file(locationFeed);
+    string line, partial;
+    Vector<LocationUpdate> chunk;
+    long long lines = 0, malformed = 0;
 
-    if (bestRider == -1)
+    while (locationStreamRunning)
     {
-        for (int i = 0; i < riders.size(); i++)
+        while (chunk.size() < 4096 && getline(file, line))
         {
-            if (riders[i].canCarry(requiredCapacity))
+            if (file.eof())
             {
-
-                LinkedList<Graph<City>::Edge> *neighbors = cityMap.getNeighbors(cityID);
-                if (neighbors)
-                {
-                    for (auto &edge : *neighbors)
-                    {
-                        if (edge.destID == riders[i].currentCityID && !isEdgeBlocked(cityID, edge.destID))
-                        {
-
-                            int available = riders[i].getAvailableCapacity();
-                            int distance = edge.weight;
-
-                            if (bestRider == -1 ||
-                                (bestDistance == -1 || distance < bestDistance) ||
-                                (distance == bestDistance && available > bestAvailableCapacity))
-                            {
-                                bestRider = riders[i].riderID;
-                                bestAvailableCapacity = available;
-                                bestDistance = distance;
-                            }
-                            break;
-                        }
-                    }
-                }
+                partial += line;
+                break;
+            }
+            if (!partial.empty())
+            {
+                line = partial + line;
+                partial.clear();
             }
+
+            LocationUpdate update;
+            if (CSVUtils::parseLocationLine(line, update))
+                chunk.push_back(update);
+            else if (!line.empty() && line[0] >= '0' && line[0] <= '9')
+                malformed++;
+            lines++;
         }
 
-        if (bestRider == -1)
+        if (lines > 0)
         {
-            for (int i = 0; i < riders.size(); i++)
+            lock_guard<mutex> lock(locationMutex);
+            locationLinesRead += lines;
+            locationMalformed += malformed;
+            lines = 0;
+            malformed = 0;
+            HashTable<int, LocationUpdate> &inbox = locationBuffers[locationInbox];
+            for (int i = 0; i < chunk.size(); i++)
             {
-                if (riders[i].canCarry(requiredCapacity))
+                LocationUpdate *queued = inbox.get(chunk[i].riderID);
+                if (!queued)
                 {
-                    int available = riders[i].getAvailableCapacity();
-                    if (bestRider == -1 || available > bestAvailableCapacity)
-                    {
-                        bestRider = riders[i].riderID;
-                        bestAvailableCapacity = available;
-                    }
+                    inbox.insert(chunk[i].riderID, chunk[i]);
+                    continue;
                 }
+                locationCoalesced++;
+                if (chunk[i].timestamp >= queued->timestamp)
+                    *queued = chunk[i];
             }
+            chunk.clear();
+        }
 
-            if (bestRider != -1)
-            {
-                for (int i = 0; i < riders.size(); i++)
-                {
-                    if (riders[i].riderID == bestRider)
-                    {
-                        if (riders[i].currentCityID != cityID)
-                        {
-                            cout << "[INFO] Rider " << riders[i].name << " is moving from city " << riders[i].currentCityID
-                                 << " to city " << cityID << " for pickup.\n";
-                            riders[i].currentCityID = cityID;
-                        }
-                        break;
-                    }
-                }
-            }
+        if (file.eof() || file.fail())
+        {
+            file.clear();
+            this_thread::sleep_for(chrono::milliseconds(20));
         }
     }
+}
 
-    return bestRider;
+void CourierSystem::drainLocationUpdates()
+{
+    HashTable<int, LocationUpdate> *batch;
+    {
+        lock_guard<mutex> lock(locationMutex);
+        if (locationBuffers[locationInbox].empty())
+            return;
+        batch = &locationBuffers[locationInbox];
+        locationInbox ^= 1;
+    }
+
+    Vector<int> riderIDs = batch->getAllKeys();
+    for (int i = 0; i < riderIDs.size(); i++)
+    {
+        LocationUpdate update = *batch->get(riderIDs[i]);
+        Rider *rider = findRider(update.riderID);
+        long long *seen = locationStamps.get(update.riderID);
+        if (!rider || !validateCityID(update.cityID) || (seen && *seen > update.timestamp))
+        {
+            locationRejected++;
+            continue;
+        }
+
+        locationStamps.insert(update.riderID, update.timestamp);
+        if (rider->currentCityID != update.cityID)
+        {
+            rider->currentCityID = update.cityID;
+            riderTours.remove(rider->riderID);
+            touchRider(*rider);
+        }
+        locationApplied++;
+    }
+    batch->clear();
+    locationBatches++;
 }
 
-void CourierSystem::completeDelivery()
+void CourierSystem::startLocationStream(const string &filename)
 {
-    if (transitQueue.empty())
+    if (locationReader)
     {
-        cout << "\n[INFO] No parcels currently in Transit.\n";
+        cout << "\n[WARNING] A location feed is already running from " << locationFeed << ".\n";
         return;
     }
 
-    Parcel top = transitQueue.front();
-    transitQueue.pop();
+    ifstream probe(filename);
+    if (!probe.is_open())
+    {
+        cout << "\n[ERROR] Could not open " << filename << ".\n";
+        return;
+    }
+    probe.close();
 
-    Parcel *parcel = findParcel(top.trackingID);
-    if (!parcel)
+    locationFeed = filename;
+    locationStreamRunning = true;
+    locationReader = new thread(&CourierSystem::readLocationFeed, this);
+    cout << "\n[SUCCESS] Following " << filename << " for rider positions (RiderID,CityID,Timestamp).\n";
+}
+
+void CourierSystem::stopLocationStream()
+{
+    if (!locationReader)
+    {
+        cout << "\n[INFO] No location feed is running.\n";
         return;
+    }
 
-    string prevState = parcel->getStatusStr();
-    parcel->status = Status::Delivered;
-    parcel->currentCityID = parcel->destCityID;
+    locationStreamRunning = false;
+    locationReader->join();
+    delete locationReader;
+    locationReader = nullptr;
+    drainLocationUpdates();
+    saveData();
+    cout << "\n[SUCCESS] Location feed stopped. " << locationApplied << " update(s) applied in total.\n";
+}
 
-    City *destCity = cityMap.getNodeData(parcel->destCityID);
-    string destName = destCity ? destCity->name : to_string(parcel->destCityID);
-    parcel->history.push_back(getCurrentTimestamp() + " - Delivered to " + parcel->receiverName + " at " + destName);
+bool CourierSystem::isLocationStreamRunning() const
+{
+    return locationReader != nullptr;
+}
 
-    int assignedRiderID = -1;
-    for (int i = 0; i < riders.size(); i++)
-    {
-        for (int j = 0; j < riders[i].assignedParcels.size(); j++)
-        {
-            if (riders[i].assignedParcels[j] == parcel->trackingID)
-            {
-                assignedRiderID = riders[i].riderID;
-                riders[i].currentLoad -= parcel->weight;
-                riders[i].currentCityID = parcel->destCityID;
+void CourierSystem::displayLocationStreamStatus()
+{
+    drainLocationUpdates();
 
-                for (int k = j; k < riders[i].assignedParcels.size() - 1; k++)
-                {
-                    riders[i].assignedParcels[k] = riders[i].assignedParcels[k + 1];
-                }
-                riders[i].assignedParcels.pop_back();
-                break;
-            }
-        }
+    long long linesRead, malformed, coalesced;
+    {
+        lock_guard<mutex> lock(locationMutex);
+        linesRead = locationLinesRead;
+        malformed = locationMalformed;
+        coalesced = locationCoalesced;
     }
 
-    saveData();
+    Table t;
+    t.addHeader("Metric");
+    t.addHeader("Value");
+    t.addRow({"Feed", locationReader ? locationFeed : "(stopped)"});
+    t.addRow({"Lines read", to_string(linesRead)});
+    t.addRow({"Malformed lines", to_string(malformed)});
+    t.addRow({"Superseded before apply", to_string(coalesced)});
+    t.addRow({"Updates applied", to_string(locationApplied)});
+    t.addRow({"Rejected (unknown/out of order)", to_string(locationRejected)});
+    t.addRow({"Batches", to_string(locationBatches)});
+
+    cout << "\n=== Rider Location Feed ===\n";
+    t.print();
+}
 
-    logOperation(OperationType::CompleteDelivery, top.trackingID, prevState, "Delivered", assignedRiderID);
-    cout << "\n[SUCCESS] Parcel " << top.trackingID << " Delivered to " << destName << "!\n";
+int CourierSystem::currentDispatchMinute() const
+{
+    if (dispatchClock >= 0)
+        return dispatchClock;
+    time_t now = time(0);
+    tm *timeinfo = localtime(&now);
+    return timeinfo->tm_hour * 60 + timeinfo->tm_min;
 }
 
-void CourierSystem::completeDeliveryByID(int parcelID)
+string CourierSystem::formatClock(int minute)
 {
-    Parcel *parcel = findParcel(parcelID);
-    if (!parcel)
-    {
-        cout << "\n[ERROR] Parcel ID not found.\n";
-        return;
-    }
+    ostringstream out;
+    out << setfill('0') << setw(2) << minute / 60 << ":" << setw(2) << minute % 60;
+    return out.str();
+}
 
-    if (parcel->status != Status::InTransit)
+void CourierSystem::rebuildAvailability(int riderID)
+{
+    Vector<ShiftWindow> *windows = riderShifts.get(riderID);
+    if (!windows || windows->empty())
     {
-        cout << "\n[ERROR] Parcel is not in Transit status. Current status: " << parcel->getStatusStr() << "\n";
+        riderAvailability.remove(riderID);
         return;
     }
 
-    if (!transitQueue.remove(*parcel))
+    bool anyShift = false;
+    for (int i = 0; i < windows->size(); i++)
     {
-        cout << "\n[WARNING] Parcel not found in transit queue, but proceeding...\n";
+        if (!(*windows)[i].isBreak)
+            anyShift = true;
     }
 
-    string prevState = parcel->getStatusStr();
-    parcel->status = Status::Delivered;
-    parcel->currentCityID = parcel->destCityID;
-
-    City *destCity = cityMap.getNodeData(parcel->destCityID);
-    string destName = destCity ? destCity->name : to_string(parcel->destCityID);
-    parcel->history.push_back(getCurrentTimestamp() + " - Delivered to " + parcel->receiverName + " at " + destName);
-
-    int assignedRiderID = -1;
-    for (int i = 0; i < riders.size(); i++)
+    Vector<bool> free(1440, !anyShift);
+    for (int pass = 0; pass < 2; pass++)
     {
-        for (int j = 0; j < riders[i].assignedParcels.size(); j++)
+        for (int i = 0; i < windows->size(); i++)
         {
-            if (riders[i].assignedParcels[j] == parcelID)
+            const ShiftWindow &window = (*windows)[i];
+            if (window.isBreak != (pass == 1))
+                continue;
+            int length = (window.end - window.start + 1440) % 1440;
+            if (length == 0)
+                length = 1440;
+            for (int k = 0; k < length; k++)
             {
-                assignedRiderID = riders[i].riderID;
-                riders[i].currentLoad -= parcel->weight;
-                riders[i].currentCityID = parcel->destCityID;
-
-                for (int k = j; k < riders[i].assignedParcels.size() - 1; k++)
-                {
-                    riders[i].assignedParcels[k] = riders[i].assignedParcels[k + 1];
-                }
-                riders[i].assignedParcels.pop_back();
-                break;
+                free[(window.start + k) % 1440] = !window.isBreak;
             }
         }
     }
 
-    saveData();
-
-    logOperation(OperationType::CompleteDelivery, parcelID, prevState, "Delivered", assignedRiderID);
-    cout << "\n[SUCCESS] Parcel " << parcelID << " Delivered to " << destName << "!\n";
+    Vector<ShiftWindow> available;
+    for (int m = 0; m < 1440; m++)
+    {
+        if (!free[m])
+            continue;
+        int start = m;
+        while (m < 1440 && free[m])
+        {
+            m++;
+        }
+        available.push_back(ShiftWindow(start, m, false));
+    }
+    riderAvailability.insert(riderID, available);
 }
 
-void CourierSystem::recordDispatch(int trackingID)
+void CourierSystem::rebuildShiftBoundaries()
 {
-    Parcel *parcel = findParcel(trackingID);
-    if (!parcel)
+    shiftBoundaries = Vector<Vector<int>>(1440, Vector<int>());
+    Vector<int> riderIDs = riderAvailability.getAllKeys();
+    for (int i = 0; i < riderIDs.size(); i++)
     {
-        cout << "\n[ERROR] Parcel ID " << trackingID << " not found.\n";
-        return;
+        Vector<ShiftWindow> &available = *riderAvailability.get(riderIDs[i]);
+        for (int j = 0; j < available.size(); j++)
+        {
+            shiftBoundaries[available[j].start].push_back(riderIDs[i]);
+            shiftBoundaries[available[j].end % 1440].push_back(riderIDs[i]);
+        }
+        if (available.empty())
+            shiftBoundaries[0].push_back(riderIDs[i]);
     }
-    if (parcel->status != Status::InWarehouse && parcel->status != Status::InTransit)
-    {
-        cout << "\n[WARNING] Parcel is not in Warehouse or Transit status. Current: " << parcel->getStatusStr() << "\n";
+}
+
+bool CourierSystem::isRiderOnShift(int riderID, int minute) const
+{
+    const Vector<ShiftWindow> *available = riderAvailability.get(riderID);
+    if (!available)
+        return true;
+
+    int lo = 0, hi = available->size() - 1;
+    while (lo <= hi)
+    {
+        int mid = (lo + hi) / 2;
+        if ((*available)[mid].end <= minute)
+            lo = mid + 1;
+        else if ((*available)[mid].start > minute)
+            hi = mid - 1;
+        else
+            return true;
     }
-    parcel->history.push_back(getCurrentTimestamp() + " - Dispatched from warehouse");
-    saveData();
-    cout << "\n[SUCCESS] Dispatch recorded for parcel " << trackingID << ".\n";
+    return false;
 }
 
-void CourierSystem::recordLoading(int trackingID, int cityID)
+void CourierSystem::syncShiftClock()
 {
-    Parcel *parcel = findParcel(trackingID);
-    if (!parcel)
-    {
-        cout << "\n[ERROR] Parcel ID " << trackingID << " not found.\n";
+    int now = currentDispatchMinute();
+    if (now == shiftClockMinute)
         return;
-    }
-    if (!validateCityID(cityID))
+
+    int from = shiftClockMinute;
+    shiftClockMinute = now;
+    for (int m = (from + 1) % 1440;; m = (m + 1) % 1440)
     {
-        cout << "\n[ERROR] Invalid City ID: " << cityID << "\n";
-        return;
+        for (int i = 0; i < shiftBoundaries[m].size(); i++)
+        {
+            Rider *rider = findRider(shiftBoundaries[m][i]);
+            if (rider)
+                touchRider(*rider);
+        }
+        if (m == now)
+            break;
     }
-    City *city = cityMap.getNodeData(cityID);
-    string cityName = city ? city->name : to_string(cityID);
-    parcel->history.push_back(getCurrentTimestamp() + " - Loaded at " + cityName);
-    parcel->currentCityID = cityID;
-    saveData();
-    cout << "\n[SUCCESS] Loading recorded for parcel " << trackingID << " at " << cityName << ".\n";
 }
 
-void CourierSystem::recordUnloading(int trackingID, int cityID)
+void CourierSystem::refreshRiderSchedule(Rider &rider)
 {
-    Parcel *parcel = findParcel(trackingID);
-    if (!parcel)
+    rebuildAvailability(rider.riderID);
+    rebuildShiftBoundaries();
+    shiftTrees.remove(rider.currentCityID);
+    syncShiftClock();
+    touchRider(rider);
+    CSVUtils::saveShifts("shifts.csv", riderShifts);
+}
+
+void CourierSystem::addRiderShift(int riderID, int startMinute, int endMinute, bool isBreak)
+{
+    Rider *rider = findRider(riderID);
+    if (!rider)
     {
-        cout << "\n[ERROR] Parcel ID " << trackingID << " not found.\n";
+        cout << "\n[ERROR] Rider not found.\n";
         return;
     }
-    if (!validateCityID(cityID))
+    if (startMinute < 0 || startMinute >= 1440 || endMinute < 0 || endMinute >= 1440)
     {
-        cout << "\n[ERROR] Invalid City ID: " << cityID << "\n";
+        cout << "\n[ERROR] Times must be between 00:00 and 23:59.\n";
         return;
     }
-    City *city = cityMap.getNodeData(cityID);
-    string cityName = city ? city->name : to_string(cityID);
-    parcel->history.push_back(getCurrentTimestamp() + " - Unloaded at " + cityName);
-    parcel->currentCityID = cityID;
-    saveData();
-    cout << "\n[SUCCESS] Unloading recorded for parcel " << trackingID << " at " << cityName << ".\n";
-}
-
-void CourierSystem::recordDeliveryAttempt(int trackingID, bool success)
-{
-    Parcel *parcel = findParcel(trackingID);
-    if (!parcel)
-        return;
 
-    parcel->deliveryAttempts++;
-    if (success)
+    Vector<ShiftWindow> *windows = riderShifts.get(riderID);
+    if (!windows)
     {
-        parcel->status = Status::Delivered;
-        parcel->history.push_back(getCurrentTimestamp() + " - Delivery successful (Attempt " + to_string(parcel->deliveryAttempts) + ")");
+        riderShifts.insert(riderID, Vector<ShiftWindow>());
+        windows = riderShifts.get(riderID);
     }
-    else
+    windows->push_back(ShiftWindow(startMinute, endMinute, isBreak));
+    refreshRiderSchedule(*rider);
+
+    cout << "\n[SUCCESS] " << (isBreak ? "Break " : "Shift ") << formatClock(startMinute) << "-" << formatClock(endMinute)
+         << " added for " << rider->name << ".\n";
+}
+
+void CourierSystem::clearRiderShifts(int riderID)
+{
+    Rider *rider = findRider(riderID);
+    if (!rider)
     {
-        parcel->history.push_back(getCurrentTimestamp() + " - Delivery attempt failed (Attempt " + to_string(parcel->deliveryAttempts) + ")");
-        if (parcel->deliveryAttempts >= 3)
-        {
-            returnToSender(trackingID);
-        }
+        cout << "\n[ERROR] Rider not found.\n";
+        return;
     }
+
+    riderShifts.remove(riderID);
+    refreshRiderSchedule(*rider);
+    cout << "\n[SUCCESS] " << rider->name << " is available around the clock again.\n";
 }
 
-void CourierSystem::returnToSender(int trackingID)
+void CourierSystem::displayRiderShifts(int riderID)
 {
-    Parcel *parcel = findParcel(trackingID);
-    if (!parcel)
+    Rider *rider = findRider(riderID);
+    if (!rider)
     {
-        cout << "\n[ERROR] Parcel ID " << trackingID << " not found.\n";
+        cout << "\n[ERROR] Rider not found.\n";
         return;
     }
 
-    if (parcel->status == Status::Delivered)
+    syncShiftClock();
+    cout << "\n=== Schedule for " << rider->name << " ===\n";
+    Vector<ShiftWindow> *windows = riderShifts.get(riderID);
+    if (!windows || windows->empty())
     {
-        cout << "\n[ERROR] Cannot return delivered parcel to sender.\n";
+        cout << "No shifts recorded; available around the clock.\n";
         return;
     }
 
-    string prevState = parcel->getStatusStr();
-    parcel->status = Status::Returned;
+    Table t;
+    t.addHeader("Type");
+    t.addHeader("From");
+    t.addHeader("To");
+    for (int i = 0; i < windows->size(); i++)
+    {
+        t.addRow({(*windows)[i].isBreak ? "Break" : "Shift", formatClock((*windows)[i].start), formatClock((*windows)[i].end)});
+    }
+    t.print();
 
-    removeParcelFromQueue(transitQueue, trackingID);
+    Vector<ShiftWindow> &available = *riderAvailability.get(riderID);
+    cout << "Available: ";
+    for (int i = 0; i < available.size(); i++)
+    {
+        cout << (i > 0 ? ", " : "") << formatClock(available[i].start) << "-" << formatClock(available[i].end);
+    }
+    if (available.empty())
+        cout << "never";
+    cout << "\nOn shift at " << formatClock(shiftClockMinute) << ": " << (isRiderOnShift(riderID, shiftClockMinute) ? "Yes" : "No") << "\n";
+}
 
-    parcel->history.push_back(getCurrentTimestamp() + " - Returned to sender after " + to_string(parcel->deliveryAttempts) + " failed attempts");
+int CourierSystem::findRidersFreeBetween(int cityID, int fromMinute, int toMinute, int requiredCapacity, Vector<int> &riderIDs)
+{
+    riderIDs.clear();
+    drainLocationUpdates();
+    syncShiftClock();
 
-    for (int i = 0; i < riders.size(); i++)
+    IntervalTree *tree = shiftTrees.get(cityID);
+    if (!tree)
     {
-        for (int j = 0; j < riders[i].assignedParcels.size(); j++)
+        IntervalTree built;
+        Vector<int> *roster = cityRosters.get(cityID);
+        for (int i = 0; roster && i < roster->size(); i++)
         {
-            if (riders[i].assignedParcels[j] == trackingID)
+            Vector<ShiftWindow> *available = riderAvailability.get((*roster)[i]);
+            if (!available)
             {
-                riders[i].currentLoad -= parcel->weight;
-                for (int k = j; k < riders[i].assignedParcels.size() - 1; k++)
-                {
-                    riders[i].assignedParcels[k] = riders[i].assignedParcels[k + 1];
-                }
-                riders[i].assignedParcels.pop_back();
-                break;
+                built.insert(0, 1440, (*roster)[i]);
+                continue;
+            }
+            for (int j = 0; j < available->size(); j++)
+            {
+                built.insert((*available)[j].start, (*available)[j].end, (*roster)[i]);
             }
         }
+        built.rebuild();
+        shiftTrees.insert(cityID, built);
+        tree = shiftTrees.get(cityID);
     }
 
-    saveData();
-    logOperation(OperationType::ReturnToSender, trackingID, prevState, "Returned", -1);
-    cout << "\n[SUCCESS] Parcel " << trackingID << " returned to sender.\n";
+    Vector<int> candidates;
+    if (fromMinute < toMinute)
+    {
+        tree->containing(fromMinute, toMinute, candidates);
+    }
+    else if (fromMinute == toMinute)
+    {
+        tree->containing(fromMinute, fromMinute + 1, candidates);
+    }
+    else
+    {
+        Vector<int> late, early;
+        tree->containing(fromMinute, 1440, late);
+        tree->containing(0, toMinute, early);
+        HashTable<int, bool> morning;
+        for (int i = 0; i < early.size(); i++)
+        {
+            morning.insert(early[i], true);
+        }
+        for (int i = 0; i < late.size(); i++)
+        {
+            if (toMinute == 0 || morning.contains(late[i]))
+                candidates.push_back(late[i]);
+        }
+    }
+
+    for (int i = 0; i < candidates.size(); i++)
+    {
+        Rider *rider = findRider(candidates[i]);
+        if (rider && rider->getAvailableCapacity() >= requiredCapacity)
+            riderIDs.push_back(candidates[i]);
+    }
+    sort(riderIDs.begin(), riderIDs.end());
+    return riderIDs.size();
 }
 
-void CourierSystem::addRider(string name, int capacity, int cityID)
+void CourierSystem::displayRidersFreeBetween(int cityID, int fromMinute, int toMinute, int requiredCapacity)
 {
-    Rider newRider(nextRiderID++, name, capacity, cityID);
-    riders.push_back(newRider);
-
-    CSVUtils::saveRider("riders.csv", newRider.riderID, name, capacity, cityID);
+    if (!validateCityID(cityID))
+    {
+        cout << "\n[ERROR] Invalid city ID.\n";
+        return;
+    }
 
-    cout << "\n[SUCCESS] Rider '" << name << "' added with ID: " << newRider.riderID << "\n";
-}
+    Vector<int> riderIDs;
+    City *city = cityMap.getNodeData(cityID);
+    if (findRidersFreeBetween(cityID, fromMinute, toMinute, requiredCapacity, riderIDs) == 0)
+    {
+        cout << "\n[INFO] No rider in " << city->name << " is free " << formatClock(fromMinute) << "-" << formatClock(toMinute)
+             << " with " << requiredCapacity << " kg available.\n";
+        return;
+    }
 
-void CourierSystem::displayRiders()
-{
     Table t;
     t.addHeader("Rider ID");
     t.addHeader("Name");
-    t.addHeader("Capacity (kg)");
-    t.addHeader("Current Load (kg)");
     t.addHeader("Available (kg)");
-    t.addHeader("Location");
-
-    for (int i = 0; i < riders.size(); i++)
+    for (int i = 0; i < riderIDs.size(); i++)
     {
-        City *city = cityMap.getNodeData(riders[i].currentCityID);
-        string cityName = city ? city->name : to_string(riders[i].currentCityID);
-        t.addRow({to_string(riders[i].riderID),
-                  riders[i].name,
-                  to_string(riders[i].capacity),
-                  to_string(riders[i].currentLoad),
-                  to_string(riders[i].getAvailableCapacity()),
-                  cityName});
+        Rider *rider = findRider(riderIDs[i]);
+        t.addRow({to_string(rider->riderID), rider->name, to_string(rider->getAvailableCapacity())});
     }
 
-    cout << "\n=== All Riders ===\n";
+    cout << "\n=== Riders in " << city->name << " free " << formatClock(fromMinute) << "-" << formatClock(toMinute) << " ===\n";
     t.print();
 }
 
-void CourierSystem::displayRiderLoad(int riderID)
-{
-    for (int i = 0; i < riders.size(); i++)
-    {
-        if (riders[i].riderID == riderID)
-        {
-            Table t;
-            t.addHeader("Parcel ID");
-            t.addHeader("Weight (kg)");
-            t.addHeader("Status");
-
-            for (int j = 0; j < riders[i].assignedParcels.size(); j++)
-            {
-                Parcel *parcel = findParcel(riders[i].assignedParcels[j]);
-                if (parcel)
-                {
-                    t.addRow({to_string(parcel->trackingID),
-                              to_string(parcel->weight),
-                              parcel->getStatusStr()});
-                }
-            }
-
-            cout << "\n=== Rider " << riders[i].name << " Load ===\n";
-            cout << "Total Capacity: " << riders[i].capacity << " kg\n";
-            cout << "Current Load: " << riders[i].currentLoad << " kg\n";
-            cout << "Available: " << riders[i].getAvailableCapacity() << " kg\n";
-            t.print();
-            return;
-        }
-    }
-    cout << "\n[ERROR] Rider not found.\n";
-}
-
-void CourierSystem::displayAllRiderLoads()
+void CourierSystem::setDispatchClock(int minute)
 {
-    for (int i = 0; i < riders.size(); i++)
-    {
-        displayRiderLoad(riders[i].riderID);
-    }
+    dispatchClock = minute >= 0 && minute < 1440 ? minute : -1;
+    syncShiftClock();
+    if (dispatchClock == -1)
+        cout << "\n[SUCCESS] Dispatch follows the system clock (" << formatClock(shiftClockMinute) << ").\n";
+    else
+        cout << "\n[SUCCESS] Dispatch clock set to " << formatClock(dispatchClock) << ".\n";
 }
 
 void CourierSystem::displayQueueStatus()
@@ -1844,6 +7402,7 @@ void CourierSystem::detectMissingParcels()
 
             if (!inQueue)
             {
+                releaseParcelRoute(allParcels[i]);
                 allParcels[i].status = Status::Missing;
                 missingParcels.push_back(allParcels[i].trackingID);
             }
@@ -1919,6 +7478,7 @@ void CourierSystem::undoLastOperation()
                     break;
                 }
             }
+            rebuildParcelIndex();
             nextTrackingID--;
             success = true;
         }
@@ -2020,47 +7580,27 @@ void CourierSystem::undoLastOperation()
                 cout << "[WARNING] Parcel status is " << parcel->getStatusStr() << ", expected In Transit. Proceeding anyway...\n";
             }
 
-            Rider *rider = nullptr;
-            for (int i = 0; i < riders.size(); i++)
-            {
-                if (riders[i].riderID == log.riderID)
-                {
-                    rider = &riders[i];
-                    break;
-                }
-            }
+            Rider *rider = findRider(log.riderID);
 
             if (rider)
             {
 
-                bool foundInRider = false;
-                for (int j = 0; j < rider->assignedParcels.size(); j++)
-                {
-                    if (rider->assignedParcels[j] == log.parcelID)
-                    {
-                        foundInRider = true;
-                        for (int k = j; k < rider->assignedParcels.size() - 1; k++)
-                        {
-                            rider->assignedParcels[k] = rider->assignedParcels[k + 1];
-                        }
-                        rider->assignedParcels.pop_back();
-                        break;
-                    }
-                }
-
-                if (foundInRider)
+                if (findCarrier(log.parcelID) == rider)
                 {
+                    detachParcel(log.parcelID);
                     rider->currentLoad -= parcel->weight;
                     if (rider->currentLoad < 0)
                         rider->currentLoad = 0;
+                    touchRider(*rider);
                 }
 
                 removeParcelFromQueue(transitQueue, log.parcelID);
 
                 parcel->status = Status::InWarehouse;
 
-                parcel->currentRoute.clear();
-                parcel->currentCityID = parcel->sourceCityID;
+                releaseParcelRoute(*parcel);
+                setParcelRoute(*parcel, RoutePool::NO_ROUTE);
+                parcel->currentCityID = (log.srcID != -1) ? log.srcID : parcel->sourceCityID;
 
                 if (!isParcelInHeap(warehouseQueue, log.parcelID))
                 {
@@ -2103,33 +7643,17 @@ void CourierSystem::undoLastOperation()
 
             if (log.riderID != -1)
             {
-                bool riderFound = false;
-                for (int i = 0; i < riders.size(); i++)
+                Rider *rider = findRider(log.riderID);
+                if (rider && findCarrier(log.parcelID) != rider)
                 {
-                    if (riders[i].riderID == log.riderID)
-                    {
-                        riderFound = true;
-
-                        bool alreadyAssigned = false;
-                        for (int j = 0; j < riders[i].assignedParcels.size(); j++)
-                        {
-                            if (riders[i].assignedParcels[j] == log.parcelID)
-                            {
-                                alreadyAssigned = true;
-                                break;
-                            }
-                        }
-                        if (!alreadyAssigned)
-                        {
-                            riders[i].currentLoad += parcel->weight;
-                            riders[i].assignedParcels.push_back(log.parcelID);
+                    detachParcel(log.parcelID);
+                    rider->currentLoad += parcel->weight;
+                    attachParcel(*rider, log.parcelID);
 
-                            riders[i].currentCityID = parcel->destCityID;
-                        }
-                        break;
-                    }
+                    rider->currentCityID = parcel->destCityID;
+                    touchRider(*rider);
                 }
-                if (!riderFound)
+                if (!rider)
                 {
                     cout << "[WARNING] Rider ID " << log.riderID << " not found. Continuing undo...\n";
                 }
@@ -2141,6 +7665,7 @@ void CourierSystem::undoLastOperation()
 
             parcel->status = Status::InTransit;
             parcel->currentCityID = parcel->destCityID;
+            setParcelRoute(*parcel, parcel->routeID);
 
             if (!isParcelInQueue(transitQueue, log.parcelID))
             {
@@ -2207,6 +7732,7 @@ void CourierSystem::undoLastOperation()
             removeParcelFromHeap(warehouseQueue, log.parcelID);
 
             parcel->status = Status::InTransit;
+            setParcelRoute(*parcel, parcel->routeID);
 
             if (!isParcelInQueue(transitQueue, log.parcelID))
             {
@@ -2564,6 +8090,9 @@ void CourierSystem::trackParcel(int trackingID)
     t.addRow({"Origin", src ? src->name : to_string(parcel->sourceCityID)});
     t.addRow({"Destination", dest ? dest->name : to_string(parcel->destCityID)});
     t.addRow({"Current Location", current ? current->name : (parcel->currentCityID != -1 ? to_string(parcel->currentCityID) : "Unknown")});
+    ContainerSlot *packed = parcelContainers.get(parcel->trackingID);
+    if (packed)
+        t.addRow({"Container", findContainer(packed->containerID)->getLabel()});
 
     int titleWidth = 35;
     int totalWidth = titleWidth + 2;
@@ -2589,30 +8118,31 @@ void CourierSystem::trackParcel(int trackingID)
          << RESET;
     t.print();
 
-    if (parcel->currentRoute.size() > 0)
+    Vector<int> route = getParcelRoute(*parcel);
+    if (route.size() > 0)
     {
         cout << "\n--- Assigned Route Path ---\n";
         cout << "Route: ";
-        for (int i = 0; i < parcel->currentRoute.size(); i++)
+        for (int i = 0; i < route.size(); i++)
         {
-            City *c = cityMap.getNodeData(parcel->currentRoute[i]);
+            City *c = cityMap.getNodeData(route[i]);
             if (c)
                 cout << c->name;
             else
-                cout << parcel->currentRoute[i];
+                cout << route[i];
 
-            if (i < parcel->currentRoute.size() - 1)
+            if (i < route.size() - 1)
                 cout << " -> ";
         }
         cout << "\n";
-        cout << "Total Route: " << parcel->currentRoute.size() << " cities, " << (parcel->currentRoute.size() - 1) << " segments\n";
+        cout << "Total Route: " << route.size() << " cities, " << (route.size() - 1) << " segments\n";
 
         if (parcel->status == Status::InTransit && parcel->currentCityID != -1)
         {
             int currentIndex = -1;
-            for (int i = 0; i < parcel->currentRoute.size(); i++)
+            for (int i = 0; i < route.size(); i++)
             {
-                if (parcel->currentRoute[i] == parcel->currentCityID)
+                if (route[i] == parcel->currentCityID)
                 {
                     currentIndex = i;
                     break;
@@ -2620,11 +8150,11 @@ void CourierSystem::trackParcel(int trackingID)
             }
             if (currentIndex != -1)
             {
-                cout << "Progress: At city " << (currentIndex + 1) << " of " << parcel->currentRoute.size();
-                if (currentIndex < parcel->currentRoute.size() - 1)
+                cout << "Progress: At city " << (currentIndex + 1) << " of " << route.size();
+                if (currentIndex < route.size() - 1)
                 {
-                    City *next = cityMap.getNodeData(parcel->currentRoute[currentIndex + 1]);
-                    cout << " (Next: " << (next ? next->name : to_string(parcel->currentRoute[currentIndex + 1])) << ")";
+                    City *next = cityMap.getNodeData(route[currentIndex + 1]);
+                    cout << " (Next: " << (next ? next->name : to_string(route[currentIndex + 1])) << ")";
                 }
                 cout << "\n";
             }
@@ -2633,17 +8163,11 @@ void CourierSystem::trackParcel(int trackingID)
 
     if (parcel->status == Status::InTransit)
     {
-        for (int i = 0; i < riders.size(); i++)
+        Rider *rider = findCarrier(trackingID);
+        if (rider)
         {
-            for (int j = 0; j < riders[i].assignedParcels.size(); j++)
-            {
-                if (riders[i].assignedParcels[j] == trackingID)
-                {
-                    City *riderCity = cityMap.getNodeData(riders[i].currentCityID);
-                    cout << "\nAssigned Rider: " << riders[i].name << " (Location: " << (riderCity ? riderCity->name : to_string(riders[i].currentCityID)) << ")\n";
-                    break;
-                }
-            }
+            City *riderCity = cityMap.getNodeData(rider->currentCityID);
+            cout << "\nAssigned Rider: " << rider->name << " (Location: " << (riderCity ? riderCity->name : to_string(rider->currentCityID)) << ")\n";
         }
     }
 
@@ -2712,6 +8236,8 @@ void CourierSystem::saveData()
 {
     CSVUtils::saveAllParcels("parcels.csv", allParcels);
     CSVUtils::saveAllRiders("riders.csv", riders);
+    CSVUtils::saveContainers("containers.csv", containers);
+    CSVUtils::clearContainerJournal("container_journal.csv");
     saveAdmins();
     cout << "\n[SUCCESS] All data saved to files.\n";
 }
@@ -2794,15 +8320,7 @@ void CourierSystem::displayDeliveryStatistics()
 
 void CourierSystem::displayRiderStatistics(int riderID)
 {
-    Rider *rider = nullptr;
-    for (int i = 0; i < riders.size(); i++)
-    {
-        if (riders[i].riderID == riderID)
-        {
-            rider = &riders[i];
-            break;
-        }
-    }
+    Rider *rider = findRider(riderID);
 
     if (!rider)
     {
@@ -17,6 +17,12 @@ class CourierSystem
 {
 private:
     Graph<City> cityMap;
+    OverlayGraph roadNetwork;
+    void storeCity(const City &city);
+    void storeRoad(int srcID, int destID, int distance);
+    static void overlayDistances(const OverlayGraph::View &roads, int source, Vector<int> &dist, long long *cacheMisses = nullptr);
+
+    TravelTimeTable travelTimes;
 
     
     Queue<Parcel> pickupQueue;      
@@ -34,26 +40,99 @@ private:
     int nextRiderID;
 
     
+    struct RiderSlot
+    {
+        int available;
+        int riderID;
+        int stamp;
+        bool operator<(const RiderSlot &other) const
+        {
+            if (available != other.available)
+                return available > other.available;
+            return riderID < other.riderID;
+        }
+        bool operator>(const RiderSlot &other) const
+        {
+            return other < *this;
+        }
+    };
+    HashTable<int, int> riderIndex;
+    Vector<int> riderStamp;
+    HashTable<int, MinHeap<RiderSlot>> ridersByCity;
+    MinHeap<RiderSlot> ridersByCapacity;
+
+    struct ParcelCarrier
+    {
+        int riderID;
+        int slot;
+    };
+    HashTable<int, ParcelCarrier> parcelCarriers;
+
+    
     Vector<Admin> admins;
 
     
     Vector<BlockedEdge> blockedEdges;
 
     
+    static const int DEFAULT_EDGE_CAPACITY = 100;
+    static const int OVERLOAD_RELEASE_PERCENT = 80;
+    static const int HIGH_LOAD_PERCENT = 50;
+
     struct OverloadedEdge
     {
         int srcID;
         int destID;
         int currentLoad;
         int maxCapacity;
-        OverloadedEdge() : srcID(-1), destID(-1), currentLoad(0), maxCapacity(100) {}
-        OverloadedEdge(int s, int d, int load, int cap) : srcID(s), destID(d), currentLoad(load), maxCapacity(cap) {}
+        int reportedLoad;
+        int routedLoad;
+        bool overloaded;
+        OverloadedEdge() : srcID(-1), destID(-1), currentLoad(0), maxCapacity(DEFAULT_EDGE_CAPACITY),
+                           reportedLoad(0), routedLoad(0), overloaded(false) {}
+        OverloadedEdge(int s, int d, int load, int cap) : srcID(s), destID(d), currentLoad(load), maxCapacity(cap),
+                                                          reportedLoad(load), routedLoad(0), overloaded(false) {}
     };
     Vector<OverloadedEdge> overloadedEdges;
+    HashTable<long long, int> edgeLoadIndex;
+    HashTable<int, int> routeLoads;
+    RoutePool routePool;
 
     
     Stack<OperationLog> operationHistory;
 
+    
+    int graphVersion;
+    int overloadVersion;
+    bool trafficAssignmentEnabled;
+    int assignmentVersion;
+    HashTable<int, int> trafficAssigned;
+
+    
+    int networkTransactionDepth;
+    int pendingNetworkChanges;
+    bool pendingFullReroute;
+    HashTable<long long, int> pendingDegradedEdges;
+
+    
+    DisjointSet openComponents;
+    DisjointSet roadComponents;
+    HashTable<int, int> cityIndex;
+    HashTable<long long, int> forestEdges;
+    bool connectivityDirty;
+    int connectivityVersion;
+    int vulnerabilityVersion;
+    Vector<int> articulationCities;
+    Vector<long long> bridgeEdges;
+    Vector<int> bridgeCutOff;
+
+    
+    Vector<int> hubCities;
+    HashTable<long long, Vector<ReachableCity>> serviceAreaCache;
+    int serviceAreaVersion;
+    int routingVersion;
+    int routingOverloadVersion;
+
     int nextTrackingID;
 
     
@@ -67,7 +146,264 @@ private:
     bool isEdgeBlocked(int srcID, int destID) const;
 
     
+    static long long edgeKey(int srcID, int destID);
+    void onNetworkChanged(bool rerouteAll = true);
+    void onEdgeDegraded(int srcID, int destID);
+    void flushNetworkChanges();
+    void rerouteActiveParcels(const HashTable<long long, int> *onlyThrough);
+
+    
+    int connectivityIndexOf(int cityID) const;
+    void rebuildConnectivity();
+    void connectivityAddCity(int cityID);
+    void connectivityOpenEdge(int srcID, int destID);
+    void connectivityCloseEdge(int srcID, int destID);
+    void computeVulnerabilities();
+
+    
+    struct RoadSnapshot
+    {
+        Vector<int> cityIDs;
+        Vector<int> offsets;
+        Vector<int> targets;
+        Vector<int> weights;
+        Vector<int> edgeOf;
+        Vector<int> edgeSrc;
+        Vector<int> edgeDest;
+        Vector<int> reverseOffsets;
+        Vector<int> reverseSources;
+        Vector<int> reverseWeights;
+        Vector<int> demandOffsets;
+        Vector<int> demandTargets;
+        Vector<int> demandParcels;
+    };
+    struct CriticalityWorkspace
+    {
+        Vector<int> dist;
+        Vector<double> sigma;
+        Vector<double> dependency;
+        Vector<int> order;
+        Vector<double> edgeScore;
+    };
+    void buildRoadSnapshot(RoadSnapshot &snapshot, bool withDemand = true, bool avoidOverloaded = false);
+    static void snapshotShortestPaths(const RoadSnapshot &snapshot, int source, int skipEdge, CriticalityWorkspace &ws);
+
+    
+    RoadSnapshot serviceSnapshot;
+    static void boundedSearch(const RoadSnapshot &snapshot, int source, int radius, Vector<int> &dist, Vector<ReachableCity> &area);
+    void syncServiceAreaCache();
+    RoadSnapshot routingSnapshot;
+    void syncRoutingSnapshot();
+
+    
+    struct HubTree
+    {
+        Vector<int> forwardDist;
+        Vector<int> forwardParent;
+        Vector<int> reverseDist;
+        Vector<int> reverseNext;
+    };
+    HashTable<int, HubTree> hubTrees;
+    static void snapshotTree(const RoadSnapshot &snapshot, int root, bool reverse, Vector<int> &dist, Vector<int> &link);
+    const HubTree *getHubTree(int hubID);
+
+    
+    struct PartitionLevel
+    {
+        Vector<int> vertexWeight;
+        Vector<int> offsets;
+        Vector<int> targets;
+        Vector<int> edgeWeights;
+        Vector<int> coarseOf;
+    };
+    struct PartitionEdge
+    {
+        int u;
+        int v;
+        int weight;
+    };
+    struct RegionPartition
+    {
+        int parts;
+        int version;
+        int overloadVersion;
+        Vector<int> regionOf;
+        Vector<int> boundarySlot;
+        Vector<Vector<int>> boundary;
+        Vector<Vector<int>> tables;
+        Vector<int> cityCount;
+        Vector<int> parcelCount;
+        int cutRoads;
+        int totalRoads;
+        RegionPartition() : parts(0), version(-1), overloadVersion(-1), cutRoads(0), totalRoads(0) {}
+    };
+    RegionPartition regions;
+    static void buildPartitionLevel(int n, Vector<PartitionEdge> &edges, PartitionLevel &level);
+    static void coarsenLevel(PartitionLevel &fine, int maxVertexWeight, PartitionLevel &coarse);
+    static void growInitialRegions(const PartitionLevel &level, int parts, Vector<int> &regionOf);
+    static void refineRegions(const PartitionLevel &level, int parts, Vector<int> &regionOf);
+    static void regionSearch(const RoadSnapshot &snapshot, const Vector<int> &regionOf, int source, bool reverse,
+                             Vector<int> &dist, Vector<int> &link, Vector<int> &touched);
+    bool partitionRegions(int parts);
+    void buildRegionTables();
+
+    
+    static constexpr double EARTH_RADIUS_KM = 6371.0;
+    KDTree cityLocator;
+    KDTree hubLocator;
+    static void toUnitVector(double latitude, double longitude, double *out);
+    static double chordToKm(double chord);
+    static double kmToChord(double km);
+    void rebuildLocators();
+    void addCityRecord(const string &name, bool located, double latitude, double longitude);
+
+    int getEdgeCapacity(int srcID, int destID) const;
+    int routeParcelWithFlows(Parcel &parcel);
+
+    
+    const OverloadedEdge *findEdgeLoad(int srcID, int destID) const;
+    OverloadedEdge &edgeLoadEntry(int srcID, int destID);
+    void updateOverloadState(OverloadedEdge &edge);
+    void adjustRouteLoad(const Vector<int> &route, int delta);
+    void setParcelRoute(Parcel &parcel, const Vector<int> &route);
+    void setParcelRoute(Parcel &parcel, int routeID);
+    void releaseParcelRoute(Parcel &parcel);
+    Vector<int> getParcelRoute(const Parcel &parcel) const;
+    void loadEdgeCapacities(const string &filename);
+
+    
     Parcel *findParcel(int trackingID);
+    void rebuildParcelIndex();
+    Rider *findRider(int riderID);
+    void rebuildRiderIndex();
+    void touchRider(const Rider &rider);
+    int bestRiderIn(MinHeap<RiderSlot> &bucket, int requiredCapacity);
+    Rider *findCarrier(int trackingID);
+    void attachParcel(Rider &rider, int trackingID);
+    Rider *detachParcel(int trackingID);
+
+    
+    bool roadMatchingEnabled;
+    Vector<int> matchDist;
+    Vector<int> matchOwner;
+    Vector<bool> matchSettled;
+    void prepareMatchSearch();
+
+    
+    static constexpr int DISPATCH_CANDIDATES = 8;
+    struct DispatchProblem
+    {
+        Vector<int> weight;
+        Vector<int> score;
+        Vector<bool> fragile;
+        Vector<Vector<int>> candidateSlot;
+        Vector<Vector<int>> candidateDistance;
+        Vector<int> riderIDs;
+        Vector<int> capacity;
+        Vector<int> load;
+    };
+    struct DispatchPlan
+    {
+        Vector<int> choice;
+        int assigned;
+        int kilograms;
+        int score;
+        long long distance;
+    };
+    static void planGreedyDispatch(const DispatchProblem &problem, DispatchPlan &plan);
+    static void planBatchDispatch(const DispatchProblem &problem, DispatchPlan &plan);
+    static void scoreDispatch(const DispatchProblem &problem, DispatchPlan &plan);
+    void applyAssignment(Parcel &parcel, Rider &rider);
+    static int parcelOriginCity(const Parcel &parcel);
+
+    
+    static constexpr int LINEHAUL_CAPACITY = 1000;
+    static constexpr int LINEHAUL_MIN_FILL_PERCENT = 60;
+    Vector<LinehaulOrder> linehaulOrders;
+
+    
+    Vector<Container> containers;
+    HashTable<int, int> containerIndex;
+    struct ContainerSlot
+    {
+        int containerID;
+        int slot;
+    };
+    HashTable<int, ContainerSlot> parcelContainers;
+    HashTable<int, ContainerSlot> containerParents;
+    int nextContainerID;
+    Container *findContainer(int containerID);
+    void rebuildContainerIndex();
+    void unpackParcel(int trackingID);
+    void unnestContainer(int containerID);
+    int applyContainerEvent(const ContainerEvent &event);
+    void journalContainerEvents(const Vector<ContainerEvent> &events);
+
+    
+    struct TourStop
+    {
+        int cityID;
+        int trackingID;
+        bool drop;
+    };
+    struct RiderTour
+    {
+        Vector<TourStop> stops;
+        Vector<int> stopAt;
+        Vector<int> path;
+        long long distance;
+        long long sequentialDistance;
+    };
+    HashTable<int, RiderTour> riderTours;
+    static long long tourCost(const Vector<Vector<int>> &matrix, const Vector<int> &node, const Vector<int> &order);
+    static bool tourFeasible(const Vector<int> &pickupOf, const Vector<int> &order, Vector<int> &position);
+    static void sequenceTour(const Vector<Vector<int>> &matrix, const Vector<int> &node, const Vector<int> &pickupOf,
+                             Vector<int> &order, int budgetMs);
+    bool buildRiderTour(const Rider &rider, RiderTour &tour, int budgetMs);
+    void discardRiderTour(int trackingID);
+
+    
+    Vector<RelocationOrder> relocationOrders;
+
+    
+    HashTable<int, LocationUpdate> locationBuffers[2];
+    int locationInbox;
+    mutex locationMutex;
+    thread *locationReader;
+    atomic<bool> locationStreamRunning;
+    string locationFeed;
+    HashTable<int, long long> locationStamps;
+    long long locationLinesRead;
+    long long locationMalformed;
+    long long locationCoalesced;
+    long long locationApplied;
+    long long locationRejected;
+    long long locationBatches;
+    void readLocationFeed();
+    void drainLocationUpdates();
+
+    
+    HashTable<int, Vector<ShiftWindow>> riderShifts;
+    HashTable<int, Vector<ShiftWindow>> riderAvailability;
+    Vector<Vector<int>> shiftBoundaries;
+    int dispatchClock;
+    int shiftClockMinute;
+    struct RosterEntry
+    {
+        int cityID;
+        int slot;
+    };
+    HashTable<int, RosterEntry> rosterEntries;
+    HashTable<int, Vector<int>> cityRosters;
+    HashTable<int, IntervalTree> shiftTrees;
+    int currentDispatchMinute() const;
+    void rebuildAvailability(int riderID);
+    void rebuildShiftBoundaries();
+    void syncShiftClock();
+    bool isRiderOnShift(int riderID, int minute) const;
+    void placeOnRoster(const Rider &rider);
+    void refreshRiderSchedule(Rider &rider);
+    static string formatClock(int minute);
 
     
     bool validateCityID(int cityID) const;
@@ -82,6 +418,7 @@ private:
 
 public:
     CourierSystem();
+    ~CourierSystem();
 
     void loadData();
     void saveData(); 
@@ -90,6 +427,7 @@ public:
     void addParcel(string sender, string receiver, Priority priority, int weight, int srcID, int destID);
     bool removeParcel(int trackingID); 
     void addCity(string name);
+    void addCity(string name, double latitude, double longitude);
     void addRoute(int srcID, int destID, int distance);
 
     
@@ -108,8 +446,11 @@ public:
     void displayRoute(int srcID, int destID);
     void viewAllRoutes(int srcID, int destID); 
     int calculateShortestPath(int srcID, int destID, Vector<int> &path, bool avoidBlocked = true);
+    int calculateTimeDependentPath(int srcID, int destID, time_t departure, Vector<int> &path, bool avoidBlocked = true);
+    void displayTimeDependentRoute(int srcID, int destID, int departureHour, int departureMinute);
     void calculateAlternativeRoutes(int srcID, int destID, int k, Vector<Vector<int>> &routes, Vector<int> &distances);
-    void displayAlternativeRoutes(int srcID, int destID, int count);
+    void displayAlternativeRoutes(int srcID, int destID, int count, bool showTradeoffs = false);
+    void calculateParetoRoutes(int srcID, int destID, int maxRoutes, Vector<ParetoRoute> &frontier);
 
     
     void blockRoute(int srcID, int destID);
@@ -118,16 +459,75 @@ public:
     void recalculateActiveRoutes(); 
 
     
+    void beginNetworkTransaction();
+    void commitNetworkTransaction();
+    bool inNetworkTransaction() const;
+    void applyNetworkEditsFromFile(const string &filename);
+    void importRoadNetwork(const string &filename);
+    void benchmarkNodeOrdering(int cityCount, int queries);
+
+    
+    bool areCitiesConnected(int srcID, int destID, bool underClosures = true);
+    void displayNetworkVulnerabilities();
+    void analyzeRoadCriticality(int topN);
+
+    
+    void addHub(int cityID);
+    const Vector<int> &getHubs() const;
+    bool getServiceArea(int hubID, int radiusKm, Vector<ReachableCity> &area);
+    void computeAllServiceAreas(int radiusKm);
+    void displayServiceArea(int hubID, int radiusKm);
+    void displayHubServiceAreas(int radiusKm);
+
+    
+    int calculateViaHubPath(int srcID, int destID, const Vector<int> &candidateHubs, Vector<int> &path, int &chosenHub);
+    void displayViaHubRoute(int srcID, int destID, int hubID);
+
+    
+    void partitionNetwork(int regionCount);
+    int calculateRegionalPath(int srcID, int destID, Vector<int> &path);
+    void displayRegionalRoute(int srcID, int destID);
+
+    
+    int findNearestHub(double latitude, double longitude, double &distanceKm) const;
+    void findNearestCities(double latitude, double longitude, int k, Vector<ReachableCity> &result) const;
+    void findCitiesWithinRadius(double latitude, double longitude, int radiusKm, Vector<ReachableCity> &result) const;
+    void resolveNearestHubs(const Vector<double> &latitudes, const Vector<double> &longitudes,
+                            Vector<int> &hubIDs, Vector<double> &distancesKm) const;
+    void displayNearestHub(double latitude, double longitude);
+    void resolveHubsFromFile(const string &filename);
+
+    
+    void setTrafficAssignmentMode(bool enabled);
+    bool isTrafficAssignmentEnabled() const;
+    void runTrafficAssignment(bool fullRecompute = false);
+    void displayTrafficAssignment();
+
+    
     void processNextParcel();                            
     void processParcelByID(int parcelID);                
     void assignRider();                                  
     void assignRiderToParcel(int parcelID, int riderID); 
+    void batchAssignRiders(int limit);
+    void planLinehaulConsolidation(int truckCapacity);
+    void dispatchLinehaulOrders();
     int findAvailableRider(int requiredCapacity, int cityID);
+    int findNearestRiderByRoad(int requiredCapacity, int cityID, int &distance);
+    int findNearestRiders(int cityID, int requiredCapacity, int k, Vector<RiderMatch> &matches);
+    void setRoadMatchingMode(bool enabled);
+    bool isRoadMatchingEnabled() const;
     void completeDelivery();                 
     void completeDeliveryByID(int parcelID); 
     void recordDispatch(int trackingID);
     void recordLoading(int trackingID, int cityID);
     void recordUnloading(int trackingID, int cityID);
+    int createContainer(ContainerType type, int cityID);
+    void packParcels(int containerID, const Vector<int> &trackingIDs);
+    void nestContainer(int childID, int parentID);
+    void emptyContainer(int containerID);
+    void scanContainer(int containerID, int cityID, bool loading);
+    void displayContainers();
+    void displayContainerContents(int containerID);
     void recordDeliveryAttempt(int trackingID, bool success);
     void returnToSender(int trackingID);
 
@@ -136,6 +536,21 @@ public:
     void displayRiders();
     void displayRiderLoad(int riderID);
     void displayAllRiderLoads();
+    void displayNearestRiders(int cityID, int requiredCapacity, int k);
+    void planRiderTours(int budgetMs);
+    void displayRiderTour(int riderID);
+    void planFleetRebalancing();
+    void applyRelocationOrders();
+    void startLocationStream(const string &filename);
+    void stopLocationStream();
+    bool isLocationStreamRunning() const;
+    void displayLocationStreamStatus();
+    void addRiderShift(int riderID, int startMinute, int endMinute, bool isBreak);
+    void clearRiderShifts(int riderID);
+    void displayRiderShifts(int riderID);
+    int findRidersFreeBetween(int cityID, int fromMinute, int toMinute, int requiredCapacity, Vector<int> &riderIDs);
+    void displayRidersFreeBetween(int cityID, int fromMinute, int toMinute, int requiredCapacity);
+    void setDispatchClock(int minute);
 
     
     void displayQueueStatus();
@@ -171,8 +586,10 @@ public:
 
     
     void markPathAsOverloaded(int srcID, int destID, int load);
+    void setRouteCapacity(int srcID, int destID, int capacity);
     void unmarkPathAsOverloaded(int srcID, int destID);
     bool isPathOverloaded(int srcID, int destID) const;
+    int getEdgeLoadPermille(int srcID, int destID) const;
     void displayOverloadedRoutes();
 
 private:
@@ -183,15 +600,45 @@ private:
         int dist;
         bool operator<(const DijkstraNode &other) const
         {
-            return dist > other.dist; 
+            return dist < other.dist;
         }
         bool operator>(const DijkstraNode &other) const
         {
-            return dist < other.dist;
+            return dist > other.dist;
         }
     };
 
     
+    struct ParetoLabel
+    {
+        int node;
+        int dist;
+        int load;
+        int parent;
+        bool active;
+    };
+
+    struct ParetoQueueEntry
+    {
+        int dist;
+        int load;
+        int label;
+        bool operator<(const ParetoQueueEntry &other) const
+        {
+            if (dist != other.dist)
+                return dist < other.dist;
+            return load < other.load;
+        }
+        bool operator>(const ParetoQueueEntry &other) const
+        {
+            return other < *this;
+        }
+    };
+
+    
+    int edgeTravelSeconds(const Graph<City>::Edge &edge, int secondOfDay) const;
+
+    
     void findKShortestPaths(int srcID, int destID, int k, Vector<Vector<int>> &paths, Vector<int> &distances);
 };
 
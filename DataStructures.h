@@ -4,6 +4,11 @@
 #include <iostream>
 #include <string>
 #include <stdexcept>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <algorithm>
 
 using namespace std;
 
@@ -35,6 +40,16 @@ public:
     }
 
     
+    Vector(int count, const T& value) {
+        capacity = count > 10 ? count : 10;
+        currentSize = count;
+        data = new T[capacity];
+        for (int i = 0; i < currentSize; i++) {
+            data[i] = value;
+        }
+    }
+
+    
     Vector(const Vector& other) {
         capacity = other.capacity;
         currentSize = other.currentSize;
@@ -102,8 +117,22 @@ public:
     }
     
     
+    void reserve(int newCapacity) {
+        if (newCapacity <= capacity) return;
+        T* newData = new T[newCapacity];
+        for (int i = 0; i < currentSize; i++) {
+            newData[i] = data[i];
+        }
+        delete[] data;
+        data = newData;
+        capacity = newCapacity;
+    }
+    
+    
     T* begin() { return data; }
     T* end() { return data + currentSize; }
+    const T* begin() const { return data; }
+    const T* end() const { return data + currentSize; }
 };
 
 
@@ -350,6 +379,18 @@ private:
 public:
     Queue() : frontNode(nullptr), rearNode(nullptr) {}
 
+    Queue(const Queue& other) : frontNode(nullptr), rearNode(nullptr) {
+        for (QueueNode* node = other.frontNode; node; node = node->next) push(node->data);
+    }
+
+    Queue& operator=(const Queue& other) {
+        if (this != &other) {
+            while (!empty()) pop();
+            for (QueueNode* node = other.frontNode; node; node = node->next) push(node->data);
+        }
+        return *this;
+    }
+
     ~Queue() {
         while (!empty()) pop();
     }
@@ -531,90 +572,6 @@ public:
 
 
 
-template <typename T>
-class Graph {
-public:
-    struct Edge {
-        int destID;
-        int weight;
-        Edge(int d, int w) : destID(d), weight(w) {}
-    };
-
-    struct GraphNode {
-        int id;
-        T data;
-        LinkedList<Edge> adjacencyList;
-        GraphNode() : id(-1) {}
-        GraphNode(int i, T d) : id(i), data(d) {}
-    };
-
-private:
-    Vector<GraphNode> nodes;
-
-public:
-    void addNode(int id, T data) {
-        
-        for(int i=0; i<nodes.size(); i++) {
-            if(nodes[i].id == id) return; 
-        }
-        nodes.push_back(GraphNode(id, data));
-    }
-
-    void addEdge(int srcID, int destID, int weight) {
-        
-        for(int i=0; i<nodes.size(); i++) {
-            if(nodes[i].id == srcID) {
-                
-                bool exists = false;
-                for(auto& e : nodes[i].adjacencyList) {
-                    if(e.destID == destID) {
-                        exists = true;
-                        e.weight = weight; 
-                        break;
-                    }
-                }
-                if(!exists) {
-                    nodes[i].adjacencyList.push_back(Edge(destID, weight));
-                }
-                return;
-            }
-        }
-    }
-
-    
-    LinkedList<Edge>* getNeighbors(int id) {
-        for(int i=0; i<nodes.size(); i++) {
-            if(nodes[i].id == id) {
-                return &nodes[i].adjacencyList;
-            }
-        }
-        return nullptr;
-    }
-    
-    T* getNodeData(int id) {
-        for(int i=0; i<nodes.size(); i++) {
-            if(nodes[i].id == id) {
-                return &nodes[i].data;
-            }
-        }
-        return nullptr;
-    }
-
-    Vector<GraphNode>& getNodes() {
-        return nodes;
-    }
-    
-    const Vector<GraphNode>& getNodes() const {
-        return nodes;
-    }
-};
-
-
-
-
-
-
-
 template <typename K, typename V>
 class HashTable {
 private:
@@ -636,6 +593,11 @@ private:
     }
     
     
+    int hashFunction(long long key) const {
+        return static_cast<int>((key % capacity + capacity) % capacity);
+    }
+    
+    
     int hashFunction(const string& key) const {
         int hash = 0;
         for (char c : key) {
@@ -643,12 +605,47 @@ private:
         }
         return (hash + capacity) % capacity;
     }
+    
+    
+    void rehash(int newCapacity) {
+        Vector<HashNode>* oldBuckets = buckets;
+        int oldCapacity = capacity;
+        capacity = newCapacity;
+        buckets = new Vector<HashNode>[capacity];
+        for (int i = 0; i < oldCapacity; i++) {
+            for (int j = 0; j < oldBuckets[i].size(); j++) {
+                buckets[hashFunction(oldBuckets[i][j].key)].push_back(oldBuckets[i][j]);
+            }
+        }
+        delete[] oldBuckets;
+    }
 
 public:
     HashTable() : capacity(DEFAULT_CAPACITY), currentSize(0) {
         buckets = new Vector<HashNode>[capacity];
     }
     
+    
+    HashTable(const HashTable& other) : capacity(other.capacity), currentSize(other.currentSize) {
+        buckets = new Vector<HashNode>[capacity];
+        for (int i = 0; i < capacity; i++) {
+            buckets[i] = other.buckets[i];
+        }
+    }
+    
+    HashTable& operator=(const HashTable& other) {
+        if (this != &other) {
+            delete[] buckets;
+            capacity = other.capacity;
+            currentSize = other.currentSize;
+            buckets = new Vector<HashNode>[capacity];
+            for (int i = 0; i < capacity; i++) {
+                buckets[i] = other.buckets[i];
+            }
+        }
+        return *this;
+    }
+    
     ~HashTable() {
         delete[] buckets;
     }
@@ -669,6 +666,11 @@ public:
         
         buckets[index].push_back(HashNode(key, value));
         currentSize++;
+        
+        
+        if (currentSize > capacity * 2) {
+            rehash(capacity * 2 + 1);
+        }
     }
     
     
@@ -686,7 +688,20 @@ public:
     
     
     
-    bool contains(K key) {
+    const V* get(K key) const {
+        int index = hashFunction(key);
+        
+        for (int i = 0; i < buckets[index].size(); i++) {
+            if (buckets[index][i].key == key) {
+                return &(buckets[index][i].value);
+            }
+        }
+        return nullptr; 
+    }
+    
+    
+    
+    bool contains(K key) const {
         return get(key) != nullptr;
     }
     
@@ -717,6 +732,13 @@ public:
         return currentSize == 0;
     }
     
+    void clear() {
+        for (int i = 0; i < capacity; i++) {
+            buckets[i].clear();
+        }
+        currentSize = 0;
+    }
+    
     
     Vector<K> getAllKeys() {
         Vector<K> keys;
@@ -729,4 +751,1007 @@ public:
     }
 };
 
+
+
+template <typename T>
+class Graph {
+public:
+    struct Edge {
+        int destID;
+        int weight;
+        int profileID;
+        Edge(int d, int w) : destID(d), weight(w), profileID(-1) {}
+    };
+
+    struct GraphNode {
+        int id;
+        T data;
+        LinkedList<Edge> adjacencyList;
+        GraphNode() : id(-1) {}
+        GraphNode(int i, T d) : id(i), data(d) {}
+    };
+
+private:
+    Vector<GraphNode> nodes;
+    HashTable<int, int> indexByID;
+
+public:
+    void addNode(int id, T data) {
+        
+        if (indexByID.contains(id)) return;
+        indexByID.insert(id, nodes.size());
+        nodes.push_back(GraphNode(id, data));
+    }
+
+    void addEdge(int srcID, int destID, int weight) {
+        
+        LinkedList<Edge>* edges = getNeighbors(srcID);
+        if (!edges) return;
+        
+        for(auto& e : *edges) {
+            if(e.destID == destID) {
+                e.weight = weight; 
+                return;
+            }
+        }
+        edges->push_back(Edge(destID, weight));
+    }
+
+    
+    void addEdgeUnchecked(int srcID, int destID, int weight) {
+        LinkedList<Edge>* edges = getNeighbors(srcID);
+        if (edges) edges->push_back(Edge(destID, weight));
+    }
+
+    
+    bool setEdgeProfile(int srcID, int destID, int profileID) {
+        LinkedList<Edge>* edges = getNeighbors(srcID);
+        if (!edges) return false;
+        for (auto& e : *edges) {
+            if (e.destID == destID) {
+                e.profileID = profileID;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    
+    int indexOf(int id) const {
+        const int* index = indexByID.get(id);
+        return index ? *index : -1;
+    }
+    
+    
+    int nodeCount() const {
+        return nodes.size();
+    }
+    
+    LinkedList<Edge>* getNeighbors(int id) {
+        int index = indexOf(id);
+        return index == -1 ? nullptr : &nodes[index].adjacencyList;
+    }
+    
+    T* getNodeData(int id) {
+        int index = indexOf(id);
+        return index == -1 ? nullptr : &nodes[index].data;
+    }
+
+    Vector<GraphNode>& getNodes() {
+        return nodes;
+    }
+    
+    const Vector<GraphNode>& getNodes() const {
+        return nodes;
+    }
+};
+
+
+
+
+
+
+
+
+
+class DisjointSet {
+private:
+    Vector<int> parent;
+    Vector<int> setSize;
+    int setCount;
+
+public:
+    DisjointSet() : setCount(0) {}
+    
+    int add() {
+        parent.push_back(parent.size());
+        setSize.push_back(1);
+        setCount++;
+        return parent.size() - 1;
+    }
+    
+    
+    int find(int x) {
+        int root = x;
+        while (parent[root] != root) {
+            root = parent[root];
+        }
+        while (parent[x] != root) {
+            int next = parent[x];
+            parent[x] = root;
+            x = next;
+        }
+        return root;
+    }
+    
+    
+    bool unite(int a, int b) {
+        int ra = find(a);
+        int rb = find(b);
+        if (ra == rb) return false;
+        
+        if (setSize[ra] < setSize[rb]) {
+            int tmp = ra;
+            ra = rb;
+            rb = tmp;
+        }
+        parent[rb] = ra;
+        setSize[ra] += setSize[rb];
+        setCount--;
+        return true;
+    }
+    
+    bool connected(int a, int b) {
+        return find(a) == find(b);
+    }
+    
+    int componentSize(int x) {
+        return setSize[find(x)];
+    }
+    
+    int size() const {
+        return parent.size();
+    }
+    
+    int components() const {
+        return setCount;
+    }
+    
+    
+    void reset(int n) {
+        parent.clear();
+        setSize.clear();
+        setCount = 0;
+        for (int i = 0; i < n; i++) {
+            add();
+        }
+    }
+};
+
+
+class RoutePool {
+private:
+    struct RouteEntry {
+        int offset;
+        int byteLength;
+        int length;
+        int refCount;
+        long long hash;
+        RouteEntry() : offset(0), byteLength(0), length(0), refCount(0), hash(0) {}
+    };
+    Vector<unsigned char> bytes;
+    Vector<RouteEntry> entries;
+    Vector<int> freeIDs;
+    HashTable<long long, Vector<int>> byHash;
+    int wastedBytes;
+    int liveCount;
+    
+    static long long hashRoute(const Vector<int>& route) {
+        unsigned long long h = 1469598103934665603ULL;
+        for (int i = 0; i < route.size(); i++) {
+            h ^= static_cast<unsigned int>(route[i]);
+            h *= 1099511628211ULL;
+        }
+        return static_cast<long long>(h);
+    }
+    
+    
+    void appendEncoded(const Vector<int>& route) {
+        int previous = 0;
+        for (int i = 0; i < route.size(); i++) {
+            int delta = route[i] - previous;
+            unsigned int zigzag = (static_cast<unsigned int>(delta) << 1) ^ static_cast<unsigned int>(delta >> 31);
+            while (zigzag >= 0x80) {
+                bytes.push_back(static_cast<unsigned char>(zigzag | 0x80));
+                zigzag >>= 7;
+            }
+            bytes.push_back(static_cast<unsigned char>(zigzag));
+            previous = route[i];
+        }
+    }
+    
+    bool matches(int id, const Vector<int>& route) const {
+        if (entries[id].length != route.size()) return false;
+        Vector<int> stored;
+        decode(id, stored);
+        for (int i = 0; i < route.size(); i++) {
+            if (stored[i] != route[i]) return false;
+        }
+        return true;
+    }
+    
+    
+    void compact() {
+        Vector<unsigned char> packed;
+        for (int id = 0; id < entries.size(); id++) {
+            RouteEntry& entry = entries[id];
+            if (entry.refCount == 0) continue;
+            int start = packed.size();
+            for (int i = 0; i < entry.byteLength; i++) {
+                packed.push_back(bytes[entry.offset + i]);
+            }
+            entry.offset = start;
+        }
+        bytes = packed;
+        wastedBytes = 0;
+    }
+
+public:
+    static const int NO_ROUTE = -1;
+    
+    RoutePool() : wastedBytes(0), liveCount(0) {}
+    
+    
+    int intern(const Vector<int>& route) {
+        if (route.size() == 0) return NO_ROUTE;
+        
+        long long h = hashRoute(route);
+        Vector<int>* candidates = byHash.get(h);
+        if (candidates) {
+            for (int i = 0; i < candidates->size(); i++) {
+                if (matches((*candidates)[i], route)) {
+                    entries[(*candidates)[i]].refCount++;
+                    return (*candidates)[i];
+                }
+            }
+        }
+        
+        int id;
+        if (!freeIDs.empty()) {
+            id = freeIDs[freeIDs.size() - 1];
+            freeIDs.pop_back();
+        } else {
+            entries.push_back(RouteEntry());
+            id = entries.size() - 1;
+        }
+        
+        RouteEntry& entry = entries[id];
+        entry.offset = bytes.size();
+        appendEncoded(route);
+        entry.byteLength = bytes.size() - entry.offset;
+        entry.length = route.size();
+        entry.refCount = 1;
+        entry.hash = h;
+        liveCount++;
+        
+        if (candidates) {
+            candidates->push_back(id);
+        } else {
+            Vector<int> ids;
+            ids.push_back(id);
+            byHash.insert(h, ids);
+        }
+        return id;
+    }
+    
+    void retain(int id) {
+        if (id != NO_ROUTE) entries[id].refCount++;
+    }
+    
+    void release(int id) {
+        if (id == NO_ROUTE || entries[id].refCount == 0) return;
+        
+        RouteEntry& entry = entries[id];
+        if (--entry.refCount > 0) return;
+        
+        Vector<int>* candidates = byHash.get(entry.hash);
+        if (candidates) {
+            for (int i = 0; i < candidates->size(); i++) {
+                if ((*candidates)[i] == id) {
+                    (*candidates)[i] = (*candidates)[candidates->size() - 1];
+                    candidates->pop_back();
+                    break;
+                }
+            }
+            if (candidates->empty()) byHash.remove(entry.hash);
+        }
+        
+        wastedBytes += entry.byteLength;
+        liveCount--;
+        freeIDs.push_back(id);
+        if (wastedBytes > 4096 && wastedBytes * 2 > bytes.size()) {
+            compact();
+        }
+    }
+    
+    void decode(int id, Vector<int>& out) const {
+        out.clear();
+        if (id == NO_ROUTE) return;
+        
+        const RouteEntry& entry = entries[id];
+        int pos = entry.offset;
+        int previous = 0;
+        for (int i = 0; i < entry.length; i++) {
+            unsigned int zigzag = 0;
+            int shift = 0;
+            unsigned char b;
+            do {
+                b = bytes[pos++];
+                zigzag |= static_cast<unsigned int>(b & 0x7F) << shift;
+                shift += 7;
+            } while (b & 0x80);
+            int delta = static_cast<int>(zigzag >> 1) ^ -static_cast<int>(zigzag & 1);
+            previous += delta;
+            out.push_back(previous);
+        }
+    }
+    
+    Vector<int> decode(int id) const {
+        Vector<int> route;
+        decode(id, route);
+        return route;
+    }
+    
+    int length(int id) const {
+        return id == NO_ROUTE ? 0 : entries[id].length;
+    }
+    
+    int references(int id) const {
+        return id == NO_ROUTE ? 0 : entries[id].refCount;
+    }
+    
+    int uniqueRoutes() const {
+        return liveCount;
+    }
+    
+    int encodedBytes() const {
+        return bytes.size() - wastedBytes;
+    }
+};
+
+
+
+class OverlayGraph {
+public:
+    enum class NodeOrder {
+        Input,
+        BreadthFirst,
+        ReverseCuthillMcKee
+    };
+
+    struct Edge {
+        int target;
+        int weight;
+        Edge() : target(-1), weight(0) {}
+        Edge(int t, int w) : target(t), weight(w) {}
+    };
+
+    struct Core {
+        Vector<int> ids;
+        HashTable<int, int> indexByID;
+        Vector<int> offsets;
+        Vector<int> targets;
+        Vector<int> weights;
+        Core() { offsets.push_back(0); }
+    };
+
+    struct Edit {
+        int srcID;
+        int destID;
+        int weight;
+    };
+
+    struct Delta {
+        Vector<int> addedIDs;
+        HashTable<int, int> addedIndex;
+        HashTable<int, Vector<Edge>> edges;
+        HashTable<long long, int> masked;
+        Vector<Edit> log;
+    };
+
+    struct State {
+        shared_ptr<const Core> core;
+        Delta delta;
+    };
+
+    class View {
+    private:
+        shared_ptr<const State> state;
+
+    public:
+        View() {}
+        explicit View(shared_ptr<const State> s) : state(s) {}
+
+        int nodeCount() const {
+            return state->core->ids.size() + state->delta.addedIDs.size();
+        }
+
+        int indexOf(int id) const {
+            const int* index = state->core->indexByID.get(id);
+            if (index) return *index;
+            index = state->delta.addedIndex.get(id);
+            return index ? *index : -1;
+        }
+
+        int idAt(int index) const {
+            int coreCount = state->core->ids.size();
+            return index < coreCount ? state->core->ids[index] : state->delta.addedIDs[index - coreCount];
+        }
+
+        template <typename F>
+        void forEachNeighbor(int index, F visit) const {
+            const Core& core = *state->core;
+            const Delta& delta = state->delta;
+            if (index < core.ids.size()) {
+                bool anyMasked = !delta.masked.empty();
+                for (int e = core.offsets[index]; e < core.offsets[index + 1]; e++) {
+                    if (anyMasked && delta.masked.contains(edgeKey(index, core.targets[e]))) continue;
+                    visit(core.targets[e], core.weights[e]);
+                }
+            }
+            const Vector<Edge>* extra = delta.edges.get(index);
+            if (extra) {
+                for (int i = 0; i < extra->size(); i++) {
+                    visit((*extra)[i].target, (*extra)[i].weight);
+                }
+            }
+        }
+
+        int pendingEdits() const {
+            return state->delta.log.size();
+        }
+    };
+
+private:
+    static const int DEFAULT_COMPACT_THRESHOLD = 256;
+
+    shared_ptr<const State> current;
+    mutex writeMutex;
+    thread compactor;
+    atomic<bool> compacting;
+    atomic<int> compactionCount;
+    int compactThreshold;
+
+    static long long edgeKey(int srcIndex, int destIndex) {
+        return (static_cast<long long>(srcIndex) << 32) | static_cast<unsigned int>(destIndex);
+    }
+
+    static int coreEdge(const Core& core, int srcIndex, int destIndex) {
+        if (srcIndex >= core.ids.size()) return -1;
+        for (int e = core.offsets[srcIndex]; e < core.offsets[srcIndex + 1]; e++) {
+            if (core.targets[e] == destIndex) return e;
+        }
+        return -1;
+    }
+
+    static int indexIn(const State& state, int id) {
+        const int* index = state.core->indexByID.get(id);
+        if (index) return *index;
+        index = state.delta.addedIndex.get(id);
+        return index ? *index : -1;
+    }
+
+    static bool apply(State& state, const Edit& edit) {
+        Delta& delta = state.delta;
+        if (edit.destID == -1) {
+            if (indexIn(state, edit.srcID) != -1) return false;
+            delta.addedIndex.insert(edit.srcID, state.core->ids.size() + delta.addedIDs.size());
+            delta.addedIDs.push_back(edit.srcID);
+            delta.log.push_back(edit);
+            return true;
+        }
+
+        int u = indexIn(state, edit.srcID);
+        int v = indexIn(state, edit.destID);
+        if (u == -1 || v == -1) return false;
+
+        if (coreEdge(*state.core, u, v) != -1) {
+            delta.masked.insert(edgeKey(u, v), 1);
+        }
+
+        Vector<Edge>* extra = delta.edges.get(u);
+        if (extra) {
+            for (int i = 0; i < extra->size(); i++) {
+                if ((*extra)[i].target == v) {
+                    (*extra)[i] = (*extra)[extra->size() - 1];
+                    extra->pop_back();
+                    break;
+                }
+            }
+        }
+        if (!extra) {
+            delta.edges.insert(u, Vector<Edge>());
+            extra = delta.edges.get(u);
+        }
+        extra->push_back(Edge(v, edit.weight));
+        delta.log.push_back(edit);
+        return true;
+    }
+
+    static shared_ptr<Core> materialize(shared_ptr<const State> state) {
+        View view(state);
+        shared_ptr<Core> core = make_shared<Core>();
+        int n = view.nodeCount();
+        core->ids.reserve(n);
+        core->offsets.reserve(n + 1);
+        for (int i = 0; i < n; i++) {
+            core->ids.push_back(view.idAt(i));
+            core->indexByID.insert(view.idAt(i), i);
+            view.forEachNeighbor(i, [&](int target, int weight) {
+                core->targets.push_back(target);
+                core->weights.push_back(weight);
+            });
+            core->offsets.push_back(core->targets.size());
+        }
+        return core;
+    }
+
+    void compact(shared_ptr<const State> base) {
+        shared_ptr<Core> merged = materialize(base);
+        {
+            lock_guard<mutex> lock(writeMutex);
+            shared_ptr<const State> latest = atomic_load(&current);
+            shared_ptr<State> next = make_shared<State>();
+            next->core = merged;
+            for (int i = base->delta.log.size(); i < latest->delta.log.size(); i++) {
+                apply(*next, latest->delta.log[i]);
+            }
+            atomic_store(&current, shared_ptr<const State>(next));
+            compactionCount++;
+        }
+        compacting = false;
+    }
+
+    bool write(const Edit& edit) {
+        bool startCompaction = false;
+        shared_ptr<const State> base;
+        {
+            lock_guard<mutex> lock(writeMutex);
+            shared_ptr<State> next = make_shared<State>(*atomic_load(&current));
+            if (!apply(*next, edit)) return false;
+            base = next;
+            atomic_store(&current, base);
+            if (next->delta.log.size() >= compactThreshold && !compacting) {
+                compacting = true;
+                startCompaction = true;
+            }
+        }
+        if (startCompaction) {
+            if (compactor.joinable()) compactor.join();
+            compactor = thread(&OverlayGraph::compact, this, base);
+        }
+        return true;
+    }
+
+    template <typename T>
+    static Vector<int> nodeOrder(Graph<T>& graph, NodeOrder ordering) {
+        auto& nodes = graph.getNodes();
+        int n = nodes.size();
+        Vector<int> order;
+        order.reserve(n);
+        if (ordering == NodeOrder::Input) {
+            for (int i = 0; i < n; i++) order.push_back(i);
+            return order;
+        }
+
+        Vector<int> degree(n, 0);
+        for (int i = 0; i < n; i++) {
+            for (auto& edge : nodes[i].adjacencyList) {
+                if (graph.indexOf(edge.destID) != -1) degree[i]++;
+            }
+        }
+        bool byDegree = ordering == NodeOrder::ReverseCuthillMcKee;
+        auto lowerDegree = [&](int a, int b) {
+            return degree[a] != degree[b] ? degree[a] < degree[b] : a < b;
+        };
+
+        Vector<int> seeds;
+        seeds.reserve(n);
+        for (int i = 0; i < n; i++) seeds.push_back(i);
+        if (byDegree) sort(seeds.begin(), seeds.end(), lowerDegree);
+
+        Vector<bool> placed(n, false);
+        Vector<int> frontier;
+        for (int s = 0; s < n; s++) {
+            if (placed[seeds[s]]) continue;
+            placed[seeds[s]] = true;
+            int head = order.size();
+            order.push_back(seeds[s]);
+            while (head < order.size()) {
+                int u = order[head++];
+                frontier.clear();
+                for (auto& edge : nodes[u].adjacencyList) {
+                    int v = graph.indexOf(edge.destID);
+                    if (v == -1 || placed[v]) continue;
+                    placed[v] = true;
+                    frontier.push_back(v);
+                }
+                if (byDegree) sort(frontier.begin(), frontier.end(), lowerDegree);
+                for (int i = 0; i < frontier.size(); i++) order.push_back(frontier[i]);
+            }
+        }
+
+        if (byDegree) reverse(order.begin(), order.end());
+        return order;
+    }
+
+public:
+    OverlayGraph(int threshold = DEFAULT_COMPACT_THRESHOLD)
+        : compacting(false), compactionCount(0), compactThreshold(threshold) {
+        shared_ptr<State> empty = make_shared<State>();
+        empty->core = make_shared<Core>();
+        current = empty;
+    }
+
+    ~OverlayGraph() {
+        waitForCompaction();
+    }
+
+    OverlayGraph(const OverlayGraph&) = delete;
+    OverlayGraph& operator=(const OverlayGraph&) = delete;
+
+    View acquire() const {
+        return View(atomic_load(&current));
+    }
+
+    template <typename T>
+    void rebuild(Graph<T>& graph, NodeOrder ordering = NodeOrder::Input) {
+        waitForCompaction();
+        shared_ptr<Core> core = make_shared<Core>();
+        auto& nodes = graph.getNodes();
+        Vector<int> order = nodeOrder(graph, ordering);
+        core->ids.reserve(nodes.size());
+        core->offsets.reserve(nodes.size() + 1);
+        for (int i = 0; i < order.size(); i++) {
+            core->ids.push_back(nodes[order[i]].id);
+            core->indexByID.insert(nodes[order[i]].id, i);
+        }
+        for (int i = 0; i < order.size(); i++) {
+            for (auto& edge : nodes[order[i]].adjacencyList) {
+                const int* target = core->indexByID.get(edge.destID);
+                if (!target) continue;
+                core->targets.push_back(*target);
+                core->weights.push_back(edge.weight);
+            }
+            core->offsets.push_back(core->targets.size());
+        }
+
+        shared_ptr<State> next = make_shared<State>();
+        next->core = core;
+        lock_guard<mutex> lock(writeMutex);
+        atomic_store(&current, shared_ptr<const State>(next));
+    }
+
+    bool addNode(int id) {
+        Edit edit = {id, -1, -1};
+        return write(edit);
+    }
+
+    bool setEdge(int srcID, int destID, int weight) {
+        if (weight < 0) return false;
+        Edit edit = {srcID, destID, weight};
+        return write(edit);
+    }
+
+    void waitForCompaction() {
+        if (compactor.joinable()) compactor.join();
+    }
+
+    int compactions() const {
+        return compactionCount;
+    }
+};
+
+
+
+class KDTree {
+public:
+    struct Point {
+        double coord[3];
+        int id;
+    };
+
+    struct Match {
+        double dist2;
+        int id;
+    };
+
+private:
+    Vector<Point> points;
+    Vector<unsigned char> splitAxis;
+    Vector<Point> pending;
+
+    static double distance2(const Point& p, const double* q) {
+        double dx = p.coord[0] - q[0], dy = p.coord[1] - q[1], dz = p.coord[2] - q[2];
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    static void offer(Vector<Match>& best, int k, double d2, int id) {
+        if (best.size() == k && d2 >= best[k - 1].dist2) return;
+        Match m = {d2, id};
+        if (best.size() < k) best.push_back(m);
+        else best[k - 1] = m;
+        for (int i = best.size() - 1; i > 0 && best[i].dist2 < best[i - 1].dist2; i--) {
+            Match tmp = best[i];
+            best[i] = best[i - 1];
+            best[i - 1] = tmp;
+        }
+    }
+
+    void build(int lo, int hi) {
+        if (hi - lo <= 1) return;
+
+        double low[3] = {points[lo].coord[0], points[lo].coord[1], points[lo].coord[2]};
+        double high[3] = {low[0], low[1], low[2]};
+        for (int i = lo + 1; i < hi; i++) {
+            for (int a = 0; a < 3; a++) {
+                if (points[i].coord[a] < low[a]) low[a] = points[i].coord[a];
+                if (points[i].coord[a] > high[a]) high[a] = points[i].coord[a];
+            }
+        }
+        int axis = 0;
+        for (int a = 1; a < 3; a++) {
+            if (high[a] - low[a] > high[axis] - low[axis]) axis = a;
+        }
+
+        int mid = (lo + hi) / 2;
+        nth_element(points.begin() + lo, points.begin() + mid, points.begin() + hi,
+                    [axis](const Point& a, const Point& b) { return a.coord[axis] < b.coord[axis]; });
+        splitAxis[mid] = static_cast<unsigned char>(axis);
+        build(lo, mid);
+        build(mid + 1, hi);
+    }
+
+    void nearest(int lo, int hi, const double* q, int k, Vector<Match>& best) const {
+        if (lo >= hi) return;
+        int mid = (lo + hi) / 2;
+        offer(best, k, distance2(points[mid], q), points[mid].id);
+        if (hi - lo == 1) return;
+
+        double diff = q[splitAxis[mid]] - points[mid].coord[splitAxis[mid]];
+        if (diff < 0) nearest(lo, mid, q, k, best);
+        else nearest(mid + 1, hi, q, k, best);
+        if (best.size() < k || diff * diff < best[best.size() - 1].dist2) {
+            if (diff < 0) nearest(mid + 1, hi, q, k, best);
+            else nearest(lo, mid, q, k, best);
+        }
+    }
+
+    void within(int lo, int hi, const double* q, double r2, Vector<Match>& found) const {
+        if (lo >= hi) return;
+        int mid = (lo + hi) / 2;
+        double d2 = distance2(points[mid], q);
+        if (d2 <= r2) {
+            Match m = {d2, points[mid].id};
+            found.push_back(m);
+        }
+        if (hi - lo == 1) return;
+
+        double diff = q[splitAxis[mid]] - points[mid].coord[splitAxis[mid]];
+        if (diff <= 0 || diff * diff <= r2) within(lo, mid, q, r2, found);
+        if (diff >= 0 || diff * diff <= r2) within(mid + 1, hi, q, r2, found);
+    }
+
+public:
+    void clear() {
+        points.clear();
+        splitAxis.clear();
+        pending.clear();
+    }
+
+    void insert(int id, const double* coord) {
+        Point p = {{coord[0], coord[1], coord[2]}, id};
+        pending.push_back(p);
+        if (pending.size() > 32 && static_cast<long long>(pending.size()) * pending.size() > points.size()) {
+            rebuild();
+        }
+    }
+
+    void rebuild() {
+        for (int i = 0; i < pending.size(); i++) {
+            points.push_back(pending[i]);
+        }
+        pending.clear();
+        splitAxis = Vector<unsigned char>(points.size(), 0);
+        build(0, points.size());
+    }
+
+    int size() const {
+        return points.size() + pending.size();
+    }
+
+    void nearest(const double* q, int k, Vector<Match>& best) const {
+        best.clear();
+        if (k <= 0) return;
+        nearest(0, points.size(), q, k, best);
+        for (int i = 0; i < pending.size(); i++) {
+            offer(best, k, distance2(pending[i], q), pending[i].id);
+        }
+    }
+
+    void withinRadius(const double* q, double radius, Vector<Match>& found) const {
+        found.clear();
+        double r2 = radius * radius;
+        within(0, points.size(), q, r2, found);
+        for (int i = 0; i < pending.size(); i++) {
+            double d2 = distance2(pending[i], q);
+            if (d2 <= r2) {
+                Match m = {d2, pending[i].id};
+                found.push_back(m);
+            }
+        }
+        sort(found.begin(), found.end(), [](const Match& a, const Match& b) { return a.dist2 < b.dist2; });
+    }
+};
+
+
+
+class IntervalTree {
+public:
+    struct Interval {
+        int lo;
+        int hi;
+        int id;
+    };
+
+private:
+    Vector<Interval> items;
+    Vector<int> maxHi;
+    bool built;
+
+    int build(int lo, int hi) {
+        if (lo >= hi) return -2147483647 - 1;
+        int mid = (lo + hi) / 2;
+        int best = items[mid].hi;
+        int left = build(lo, mid);
+        int right = build(mid + 1, hi);
+        if (left > best) best = left;
+        if (right > best) best = right;
+        maxHi[mid] = best;
+        return best;
+    }
+
+    void containing(int lo, int hi, int a, int b, Vector<int>& ids) const {
+        if (lo >= hi) return;
+        int mid = (lo + hi) / 2;
+        if (maxHi[mid] < b) return;
+        containing(lo, mid, a, b, ids);
+        if (items[mid].lo > a) return;
+        if (items[mid].hi >= b) ids.push_back(items[mid].id);
+        containing(mid + 1, hi, a, b, ids);
+    }
+
+public:
+    IntervalTree() : built(true) {}
+
+    void clear() {
+        items.clear();
+        maxHi.clear();
+        built = true;
+    }
+
+    void insert(int lo, int hi, int id) {
+        Interval interval = {lo, hi, id};
+        items.push_back(interval);
+        built = false;
+    }
+
+    void rebuild() {
+        sort(items.begin(), items.end(), [](const Interval& a, const Interval& b) { return a.lo < b.lo; });
+        maxHi = Vector<int>(items.size(), 0);
+        build(0, items.size());
+        built = true;
+    }
+
+    int size() const {
+        return items.size();
+    }
+
+    void containing(int a, int b, Vector<int>& ids) {
+        if (!built) rebuild();
+        containing(0, items.size(), a, b, ids);
+    }
+};
+
+
+
+class MinCostFlow {
+private:
+    struct Arc {
+        int to;
+        int cap;
+        long long cost;
+    };
+
+    struct Label {
+        long long dist;
+        int node;
+        bool operator<(const Label& other) const { return dist < other.dist; }
+        bool operator>(const Label& other) const { return dist > other.dist; }
+    };
+
+    Vector<Arc> arcs;
+    Vector<Vector<int>> out;
+
+public:
+    MinCostFlow(int nodes) : out(nodes, Vector<int>()) {}
+
+    int addEdge(int from, int to, int cap, long long cost) {
+        Arc forward = {to, cap, cost};
+        Arc backward = {from, 0, -cost};
+        arcs.push_back(forward);
+        out[from].push_back(arcs.size() - 1);
+        arcs.push_back(backward);
+        out[to].push_back(arcs.size() - 1);
+        return arcs.size() - 2;
+    }
+
+    int flowOn(int edge) const {
+        return arcs[edge ^ 1].cap;
+    }
+
+    long long solve(int source, int sink, int& flow) {
+        const long long unreachable = 4000000000000000000LL;
+        int n = out.size();
+        Vector<long long> potential(n, 0);
+        Vector<long long> dist(n, unreachable);
+        Vector<int> via(n, -1);
+        long long cost = 0;
+        flow = 0;
+
+        while (true) {
+            for (int v = 0; v < n; v++) {
+                dist[v] = unreachable;
+                via[v] = -1;
+            }
+            dist[source] = 0;
+            MinHeap<Label> pq;
+            pq.push({0, source});
+            while (!pq.empty()) {
+                Label current = pq.top();
+                pq.pop();
+                if (current.dist > dist[current.node]) continue;
+                for (int i = 0; i < out[current.node].size(); i++) {
+                    int a = out[current.node][i];
+                    if (arcs[a].cap == 0) continue;
+                    int v = arcs[a].to;
+                    long long d = current.dist + arcs[a].cost + potential[current.node] - potential[v];
+                    if (d < dist[v]) {
+                        dist[v] = d;
+                        via[v] = a;
+                        pq.push({d, v});
+                    }
+                }
+            }
+            if (dist[sink] == unreachable) break;
+
+            for (int v = 0; v < n; v++) {
+                potential[v] += dist[v] < dist[sink] ? dist[v] : dist[sink];
+            }
+
+            int push = 2147483647;
+            for (int v = sink; v != source; v = arcs[via[v] ^ 1].to) {
+                if (arcs[via[v]].cap < push) push = arcs[via[v]].cap;
+            }
+            for (int v = sink; v != source; v = arcs[via[v] ^ 1].to) {
+                arcs[via[v]].cap -= push;
+                arcs[via[v] ^ 1].cap += push;
+                cost += push * arcs[via[v]].cost;
+            }
+            flow += push;
+        }
+        return cost;
+    }
+};
+
 #endif
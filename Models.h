@@ -31,9 +31,113 @@ enum class WeightCategory {
 struct City {
     int id;
 string name;
+    bool hasLocation;
+    double latitude;
+    double longitude;
     
-    City() : id(-1), name("") {}
-    City(int i, string n) : id(i), name(n) {}
+    City() : id(-1), name(""), hasLocation(false), latitude(0), longitude(0) {}
+    City(int i, string n) : id(i), name(n), hasLocation(false), latitude(0), longitude(0) {}
+    City(int i, string n, double lat, double lon) : id(i), name(n), hasLocation(true), latitude(lat), longitude(lon) {}
+};
+
+struct TravelTimeTable {
+    static const int SECONDS_PER_DAY = 86400;
+    static const int QUANTA_PER_MINUTE = 4;
+    static const int FREE_FLOW_KMH = 60;
+
+    Vector<Vector<unsigned short>> breakpointSets;
+    Vector<int> profileSet;
+    Vector<int> profileOffset;
+    Vector<unsigned short> values;
+    HashTable<string, int> setIndex;
+
+    int profileCount() const {
+        return profileSet.size();
+    }
+
+    int addProfile(const Vector<int>& minutesOfDay, const Vector<double>& travelMinutes) {
+        if (minutesOfDay.size() == 0 || minutesOfDay.size() != travelMinutes.size()) return -1;
+
+        string key;
+        for (int i = 0; i < minutesOfDay.size(); i++) {
+            if (i > 0 && minutesOfDay[i] <= minutesOfDay[i - 1]) return -1;
+            if (minutesOfDay[i] < 0 || minutesOfDay[i] >= SECONDS_PER_DAY / 60) return -1;
+            key += to_string(minutesOfDay[i]) + "|";
+        }
+
+        Vector<unsigned short> quantized;
+        for (int i = 0; i < travelMinutes.size(); i++) {
+            double q = travelMinutes[i] * QUANTA_PER_MINUTE + 0.5;
+            if (q < 1) q = 1;
+            if (q > 65535) q = 65535;
+            quantized.push_back(static_cast<unsigned short>(q));
+        }
+
+        // FIFO: travel time may fall by at most one minute per minute of departure, so leaving
+        // later never arrives earlier and the label-setting time-dependent Dijkstra stays exact.
+        int n = minutesOfDay.size();
+        for (int i = 0; n > 1 && i < n; i++) {
+            int next = (i + 1) % n;
+            int span = minutesOfDay[next] - minutesOfDay[i];
+            if (span <= 0) span += SECONDS_PER_DAY / 60;
+            if (quantized[next] - quantized[i] < -span * QUANTA_PER_MINUTE) return -1;
+        }
+
+        int* existing = setIndex.get(key);
+        int setID;
+        if (existing) {
+            setID = *existing;
+        } else {
+            Vector<unsigned short> points;
+            for (int i = 0; i < minutesOfDay.size(); i++) {
+                points.push_back(static_cast<unsigned short>(minutesOfDay[i]));
+            }
+            breakpointSets.push_back(points);
+            setID = breakpointSets.size() - 1;
+            setIndex.insert(key, setID);
+        }
+
+        profileSet.push_back(setID);
+        profileOffset.push_back(values.size());
+        for (int i = 0; i < quantized.size(); i++) {
+            values.push_back(quantized[i]);
+        }
+        return profileSet.size() - 1;
+    }
+
+    int travelSeconds(int profileID, int secondOfDay) const {
+        const Vector<unsigned short>& points = breakpointSets[profileSet[profileID]];
+        int offset = profileOffset[profileID];
+        int n = points.size();
+        if (n == 1) return values[offset] * 60 / QUANTA_PER_MINUTE;
+
+        int lo = 0, hi = n - 1, seg = n - 1;
+        while (lo <= hi) {
+            int mid = (lo + hi) / 2;
+            if (points[mid] * 60 <= secondOfDay) {
+                seg = mid;
+                lo = mid + 1;
+            } else {
+                hi = mid - 1;
+            }
+        }
+        if (secondOfDay < points[0] * 60) seg = n - 1;
+
+        int next = (seg + 1) % n;
+        int startSec = points[seg] * 60;
+        int span = points[next] * 60 - startSec;
+        if (span <= 0) span += SECONDS_PER_DAY;
+        int into = secondOfDay - startSec;
+        if (into < 0) into += SECONDS_PER_DAY;
+
+        long long a = values[offset + seg] * 60LL / QUANTA_PER_MINUTE;
+        long long b = values[offset + next] * 60LL / QUANTA_PER_MINUTE;
+        return static_cast<int>(a + (b - a) * into / span);
+    }
+
+    static int freeFlowSeconds(int distanceKm) {
+        return distanceKm * 3600 / FREE_FLOW_KMH;
+    }
 };
 
 struct Parcel {
@@ -46,18 +150,18 @@ string receiverName;
     int sourceCityID;
     int destCityID;
     int currentCityID; 
-    Vector<int> currentRoute; 
+    int routeID; 
     LinkedList<string> history;
     int deliveryAttempts; 
     bool isFragile; 
 
     Parcel() : trackingID(-1), weight(0), status(Status::Pending), sourceCityID(-1), destCityID(-1),
-               currentCityID(-1), deliveryAttempts(0), isFragile(false) {}
+               currentCityID(-1), routeID(-1), deliveryAttempts(0), isFragile(false) {}
     
     Parcel(int id, string s, string r, Priority p, int w, int src, int dest)
         : trackingID(id), senderName(s), receiverName(r), priority(p), weight(w), 
           status(Status::Pending), sourceCityID(src), destCityID(dest), currentCityID(src),
-          deliveryAttempts(0), isFragile(false) {
+          routeID(-1), deliveryAttempts(0), isFragile(false) {
         history.push_back("Parcel Created");
     }
     
@@ -200,6 +304,122 @@ struct BlockedEdge {
 };
 
 
+struct ParetoRoute {
+    Vector<int> path;
+    int distance;
+    int loadPermille;
+
+    ParetoRoute() : distance(0), loadPermille(0) {}
+};
+
+
+struct ReachableCity {
+    int cityID;
+    int distance;
+
+    ReachableCity() : cityID(-1), distance(0) {}
+    ReachableCity(int c, int d) : cityID(c), distance(d) {}
+};
+
+
+struct RiderMatch {
+    int riderID;
+    int cityID;
+    int distance;
+
+    RiderMatch() : riderID(-1), cityID(-1), distance(0) {}
+    RiderMatch(int r, int c, int d) : riderID(r), cityID(c), distance(d) {}
+};
+
+
+struct ShiftWindow {
+    int start;
+    int end;
+    bool isBreak;
+
+    ShiftWindow() : start(0), end(0), isBreak(false) {}
+    ShiftWindow(int s, int e, bool b) : start(s), end(e), isBreak(b) {}
+};
+
+
+struct LocationUpdate {
+    int riderID;
+    int cityID;
+    long long timestamp;
+
+    LocationUpdate() : riderID(-1), cityID(-1), timestamp(0) {}
+    LocationUpdate(int r, int c, long long t) : riderID(r), cityID(c), timestamp(t) {}
+};
+
+
+struct RelocationOrder {
+    int riderID;
+    int fromCityID;
+    int toCityID;
+    int distance;
+
+    RelocationOrder() : riderID(-1), fromCityID(-1), toCityID(-1), distance(0) {}
+    RelocationOrder(int r, int f, int t, int d) : riderID(r), fromCityID(f), toCityID(t), distance(d) {}
+};
+
+
+struct LinehaulOrder {
+    int orderID;
+    int fromCityID;
+    int toCityID;
+    int distance;
+    int kilograms;
+    Vector<int> corridor;
+    Vector<int> trackingIDs;
+
+    LinehaulOrder() : orderID(-1), fromCityID(-1), toCityID(-1), distance(0), kilograms(0) {}
+    LinehaulOrder(int id, int f, int t, int d) : orderID(id), fromCityID(f), toCityID(t), distance(d), kilograms(0) {}
+};
+
+
+enum class ContainerType {
+    Bag = 1,
+    Cage = 2,
+    Truck = 3
+};
+
+struct Container {
+    int containerID;
+    ContainerType type;
+    int parentID;
+    int currentCityID;
+    Vector<int> parcels;
+    Vector<int> children;
+
+    Container() : containerID(-1), type(ContainerType::Bag), parentID(-1), currentCityID(-1) {}
+    Container(int id, ContainerType t, int city) : containerID(id), type(t), parentID(-1), currentCityID(city) {}
+
+string getTypeStr() const {
+        switch(type) {
+            case ContainerType::Bag: return "Bag";
+            case ContainerType::Cage: return "Cage";
+            case ContainerType::Truck: return "Truck";
+            default: return "Unknown";
+        }
+    }
+
+string getLabel() const {
+        return getTypeStr() + " " + to_string(containerID);
+    }
+};
+
+struct ContainerEvent {
+string op;
+    int containerID;
+    int arg;
+    int cityID;
+string timestamp;
+
+    ContainerEvent() : containerID(-1), arg(-1), cityID(-1) {}
+    ContainerEvent(string o, int c, int a, int city, string ts) : op(o), containerID(c), arg(a), cityID(city), timestamp(ts) {}
+};
+
+
 struct Admin {
     string username;
     string password;
@@ -10,6 +10,7 @@
 #include <locale>
 #include <codecvt>
 #include <cstdlib>
+#include <algorithm>
 #include <windows.h>  
 #include "DataStructures.h"
 #include "Models.h"
@@ -253,7 +254,10 @@ getline(file, line);
 
         while (getline(file, line)) {
             auto tokens = split(line, ',');
-            if (tokens.size() >= 2) {
+            if (tokens.size() >= 4 && !tokens[2].empty() && !tokens[3].empty()) {
+                int id = stoi(tokens[0]);
+                graph.addNode(id, City(id, tokens[1], atof(tokens[2].c_str()), atof(tokens[3].c_str())));
+            } else if (tokens.size() >= 2) {
                 int id = stoi(tokens[0]);
 string name = tokens[1];
                 graph.addNode(id, City(id, name));
@@ -262,7 +266,246 @@ string name = tokens[1];
         file.close();
     }
 
+    struct EdgeRecord {
+        int lo;
+        int hi;
+        int weight;
+        int seq;
+    };
+    
+    struct ImportStats {
+        long long linesRead;
+        long long edgesAdded;
+        long long duplicates;
+        long long skipped;
+        long long citiesCreated;
+        long long peakBytes;
+        ImportStats() : linesRead(0), edgesAdded(0), duplicates(0), skipped(0), citiesCreated(0), peakBytes(0) {}
+    };
+    
+    
+    inline bool parseEdgeLine(const string& line, int& src, int& dest, int& weight) {
+        const char* p = line.c_str();
+        char* end;
+        long values[3];
+        for (int i = 0; i < 3; i++) {
+            while (*p == ' ' || *p == '\t') p++;
+            if (!((*p >= '0' && *p <= '9') || *p == '-')) return false;
+            values[i] = strtol(p, &end, 10);
+            p = end;
+            while (*p == ' ' || *p == '\t') p++;
+            if (i < 2) {
+                if (*p != ',') return false;
+                p++;
+            }
+        }
+        src = static_cast<int>(values[0]);
+        dest = static_cast<int>(values[1]);
+        weight = static_cast<int>(values[2]);
+        return true;
+    }
+    
+    inline bool parseLocationLine(const string& line, LocationUpdate& update) {
+        const char* p = line.c_str();
+        char* end;
+        long long values[3];
+        for (int i = 0; i < 3; i++) {
+            while (*p == ' ' || *p == '\t') p++;
+            if (!((*p >= '0' && *p <= '9') || *p == '-')) return false;
+            values[i] = strtoll(p, &end, 10);
+            p = end;
+            while (*p == ' ' || *p == '\t' || *p == '\r') p++;
+            if (i < 2) {
+                if (*p != ',') return false;
+                p++;
+            }
+        }
+        update.riderID = static_cast<int>(values[0]);
+        update.cityID = static_cast<int>(values[1]);
+        update.timestamp = values[2];
+        return true;
+    }
+    
+    
+    inline bool importEdgeList(const string& filename, Graph<City>& graph, ImportStats& stats,
+                               bool createMissingCities, bool showProgress) {
+        bool binary = filename.size() > 4 && filename.compare(filename.size() - 4, 4, ".bin") == 0;
+ifstream file(filename, binary ? ios::in | ios::binary : ios::in);
+        if (!file.is_open()) return false;
+        
+        file.seekg(0, ios::end);
+        long long fileSize = static_cast<long long>(file.tellg());
+        file.seekg(0, ios::beg);
+        
+        Vector<EdgeRecord> records;
+        records.reserve(static_cast<int>(binary ? fileSize / 12 + 1 : fileSize / 10 + 1));
+        
+        int lastPercent = -1;
+        int seq = 0;
+        auto addRecord = [&](int src, int dest, int weight) {
+            stats.linesRead++;
+            if (weight <= 0 || src == dest) {
+                stats.skipped++;
+                return;
+            }
+            EdgeRecord r;
+            r.lo = src < dest ? src : dest;
+            r.hi = src < dest ? dest : src;
+            r.weight = weight;
+            r.seq = seq++;
+            records.push_back(r);
+        };
+        auto reportProgress = [&]() {
+            if (!showProgress || fileSize <= 0) return;
+            int percent = static_cast<int>(static_cast<long long>(file.tellg()) * 100 / fileSize);
+            if (percent / 5 != lastPercent / 5) {
+                lastPercent = percent;
+                cout << "\r[INFO] Reading edges: " << percent << "% (" << stats.linesRead << " records)" << flush;
+            }
+        };
+        
+        if (binary) {
+            const int CHUNK = 65536;
+            Vector<int> buffer(CHUNK * 3, 0);
+            while (file) {
+                file.read(reinterpret_cast<char*>(buffer.begin()), CHUNK * 3 * sizeof(int));
+                int count = static_cast<int>(file.gcount() / (3 * sizeof(int)));
+                for (int i = 0; i < count; i++) {
+                    addRecord(buffer[i * 3], buffer[i * 3 + 1], buffer[i * 3 + 2]);
+                }
+                if (file) reportProgress();
+            }
+        } else {
+string line;
+            while (getline(file, line)) {
+                int src, dest, weight;
+                if (parseEdgeLine(line, src, dest, weight)) {
+                    addRecord(src, dest, weight);
+                }
+                if ((stats.linesRead & 0xFFFF) == 0) reportProgress();
+            }
+        }
+        file.close();
+        if (showProgress) cout << "\r[INFO] Reading edges: 100% (" << stats.linesRead << " records)\n";
+        
+        long long stagingBytes = static_cast<long long>(records.size()) * sizeof(EdgeRecord);
+        if (stagingBytes > stats.peakBytes) stats.peakBytes = stagingBytes;
+        
+        sort(records.begin(), records.end(), [](const EdgeRecord& a, const EdgeRecord& b) {
+            if (a.lo != b.lo) return a.lo < b.lo;
+            if (a.hi != b.hi) return a.hi < b.hi;
+            return a.seq < b.seq;
+        });
+        
+        Vector<bool> hadEdges(graph.nodeCount(), false);
+        for (int i = 0; i < graph.nodeCount(); i++) {
+            hadEdges[i] = !graph.getNodes()[i].adjacencyList.empty();
+        }
+        
+        for (int i = 0; i < records.size(); i++) {
+            if (i + 1 < records.size() && records[i + 1].lo == records[i].lo && records[i + 1].hi == records[i].hi) {
+                stats.duplicates++;
+                continue;
+            }
+            
+            const EdgeRecord& r = records[i];
+            int endpoints[2] = {r.lo, r.hi};
+            bool known = true;
+            for (int k = 0; k < 2; k++) {
+                if (graph.indexOf(endpoints[k]) != -1) continue;
+                if (createMissingCities && endpoints[k] >= 0) {
+                    graph.addNode(endpoints[k], City(endpoints[k], "City " + to_string(endpoints[k])));
+                    hadEdges.push_back(false);
+                    stats.citiesCreated++;
+                } else {
+                    known = false;
+                }
+            }
+            if (!known) {
+                stats.skipped++;
+                continue;
+            }
+            
+            if (hadEdges[graph.indexOf(r.lo)] || hadEdges[graph.indexOf(r.hi)]) {
+                graph.addEdge(r.lo, r.hi, r.weight);
+                graph.addEdge(r.hi, r.lo, r.weight);
+            } else {
+                graph.addEdgeUnchecked(r.lo, r.hi, r.weight);
+                graph.addEdgeUnchecked(r.hi, r.lo, r.weight);
+            }
+            stats.edgesAdded++;
+        }
+        return true;
+    }
+    
     inline void loadRoutes(const string& filename, Graph<City>& graph) {
+        ImportStats stats;
+        importEdgeList(filename, graph, stats, false, false);
+    }
+    
+    inline int loadTravelTimes(const string& filename, Graph<City>& graph, TravelTimeTable& table) {
+ifstream file(filename);
+        if (!file.is_open()) return 0;
+
+string line;
+getline(file, line);
+
+        int loaded = 0;
+        while (getline(file, line)) {
+            if (line.empty()) continue;
+            auto tokens = split(line, ',');
+            if (tokens.size() < 3) continue;
+
+            int src = stoi(tokens[0]);
+            int dest = stoi(tokens[1]);
+            Vector<int> minutes;
+            Vector<double> travel;
+            for (const string& point : split(tokens[2], '|')) {
+                size_t eq = point.find('=');
+                if (eq == string::npos) continue;
+                minutes.push_back(stoi(point.substr(0, eq)));
+                travel.push_back(stod(point.substr(eq + 1)));
+            }
+
+            int profileID = table.addProfile(minutes, travel);
+            if (profileID != -1 && graph.setEdgeProfile(src, dest, profileID)) {
+                loaded++;
+            }
+        }
+        file.close();
+        return loaded;
+    }
+
+    inline void saveCity(const string& filename, const City& city) {
+ofstream file(filename, ios::app);
+        if (file.is_open()) {
+            file << city.id << "," << city.name;
+            if (city.hasLocation) file << "," << fixed << setprecision(6) << city.latitude << "," << city.longitude;
+            file << "\n";
+            file.close();
+        }
+    }
+    
+    inline void saveRoute(const string& filename, int src, int dest, int dist) {
+ofstream file(filename, ios::app);
+        if (file.is_open()) {
+            file << src << "," << dest << "," << dist << "\n";
+            file.close();
+        }
+    }
+    
+    inline void saveEdgeCapacity(const string& filename, int src, int dest, int capacity) {
+        bool isNew = !ifstream(filename).good();
+ofstream file(filename, ios::app);
+        if (file.is_open()) {
+            if (isNew) file << "SrcID,DestID,Capacity\n";
+            file << src << "," << dest << "," << capacity << "\n";
+            file.close();
+        }
+    }
+    
+    
+    inline void loadHubs(const string& filename, Vector<int>& hubs) {
 ifstream file(filename);
         if (!file.is_open()) return;
 
@@ -270,36 +513,238 @@ string line;
 getline(file, line); 
 
         while (getline(file, line)) {
+            if (line.empty()) continue;
             auto tokens = split(line, ',');
-            if (tokens.size() >= 3) {
-                int src = stoi(tokens[0]);
-                int dest = stoi(tokens[1]);
-                int dist = stoi(tokens[2]);
-                graph.addEdge(src, dest, dist);
-                
-                
-                graph.addEdge(dest, src, dist); 
+            if (tokens.size() >= 1 && !tokens[0].empty()) {
+                hubs.push_back(stoi(tokens[0]));
             }
         }
         file.close();
     }
     
-    inline void saveCity(const string& filename, int id, const string& name) {
+    inline void saveHub(const string& filename, int cityID) {
+        bool isNew = !ifstream(filename).good();
 ofstream file(filename, ios::app);
         if (file.is_open()) {
-            file << id << "," << name << "\n";
+            if (isNew) file << "CityID\n";
+            file << cityID << "\n";
             file.close();
         }
     }
     
-    inline void saveRoute(const string& filename, int src, int dest, int dist) {
+    inline void saveRegionMap(const string& filename, const Vector<int>& cityIDs, const Vector<int>& regionOf,
+                              const Vector<int>& boundarySlot) {
+ofstream file(filename);
+        if (!file.is_open()) return;
+        
+        file << "CityID,Region,Boundary\n";
+        for (int i = 0; i < cityIDs.size(); i++) {
+            file << cityIDs[i] << "," << regionOf[i] + 1 << "," << (boundarySlot[i] != -1 ? 1 : 0) << "\n";
+        }
+        file.close();
+    }
+    
+    inline void saveBoundaryTables(const string& filename, const Vector<int>& cityIDs,
+                                   const Vector<Vector<int>>& boundary, const Vector<Vector<int>>& tables) {
+ofstream file(filename);
+        if (!file.is_open()) return;
+        
+        file << "Region,FromCityID,ToCityID,Distance\n";
+        for (int r = 0; r < boundary.size(); r++) {
+            int b = boundary[r].size();
+            for (int i = 0; i < b; i++) {
+                for (int j = 0; j < b; j++) {
+                    int dist = tables[r][i * b + j];
+                    if (i == j || dist == 2147483647) continue;
+                    file << r + 1 << "," << cityIDs[boundary[r][i]] << "," << cityIDs[boundary[r][j]] << "," << dist << "\n";
+                }
+            }
+        }
+        file.close();
+    }
+    
+    inline bool loadCoordinates(const string& filename, Vector<double>& latitudes, Vector<double>& longitudes) {
+ifstream file(filename);
+        if (!file.is_open()) return false;
+        
+string line;
+        while (getline(file, line)) {
+            auto tokens = split(line, ',');
+            if (tokens.size() < 2 || tokens[0].empty()) continue;
+            char first = tokens[0][0];
+            if (!((first >= '0' && first <= '9') || first == '-' || first == '.')) continue;
+            latitudes.push_back(atof(tokens[0].c_str()));
+            longitudes.push_back(atof(tokens[1].c_str()));
+        }
+        file.close();
+        return true;
+    }
+    
+    inline void saveResolvedHubs(const string& filename, const Vector<double>& latitudes, const Vector<double>& longitudes,
+                                 const Vector<int>& hubIDs, const Vector<double>& distancesKm) {
+ofstream file(filename);
+        if (!file.is_open()) return;
+        
+        file << "Latitude,Longitude,HubCityID,DistanceKm\n";
+        for (int i = 0; i < hubIDs.size(); i++) {
+            file << fixed << setprecision(6) << latitudes[i] << "," << longitudes[i] << "," << hubIDs[i] << ","
+                 << setprecision(2) << distancesKm[i] << "\n";
+        }
+        file.close();
+    }
+    
+    inline void loadShifts(const string& filename, HashTable<int, Vector<ShiftWindow>>& shifts) {
+ifstream file(filename);
+        if (!file.is_open()) return;
+        
+string line;
+        getline(file, line);
+        while (getline(file, line)) {
+            if (line.empty()) continue;
+            auto tokens = split(line, ',');
+            if (tokens.size() < 4) continue;
+            
+            int riderID = stoi(tokens[0]);
+            ShiftWindow window(stoi(tokens[1]), stoi(tokens[2]), stoi(tokens[3]) != 0);
+            Vector<ShiftWindow>* existing = shifts.get(riderID);
+            if (!existing) {
+                shifts.insert(riderID, Vector<ShiftWindow>());
+                existing = shifts.get(riderID);
+            }
+            existing->push_back(window);
+        }
+        file.close();
+    }
+    
+    inline void saveShifts(const string& filename, HashTable<int, Vector<ShiftWindow>>& shifts) {
+ofstream file(filename);
+        if (!file.is_open()) return;
+        
+        file << "RiderID,StartMinute,EndMinute,IsBreak\n";
+        Vector<int> riderIDs = shifts.getAllKeys();
+        sort(riderIDs.begin(), riderIDs.end());
+        for (int i = 0; i < riderIDs.size(); i++) {
+            Vector<ShiftWindow>& windows = *shifts.get(riderIDs[i]);
+            for (int j = 0; j < windows.size(); j++) {
+                file << riderIDs[i] << "," << windows[j].start << "," << windows[j].end << ","
+                     << (windows[j].isBreak ? 1 : 0) << "\n";
+            }
+        }
+        file.close();
+    }
+    
+    inline void saveRelocationOrders(const string& filename, const Vector<RelocationOrder>& orders) {
+ofstream file(filename);
+        if (!file.is_open()) return;
+        
+        file << "RiderID,FromCityID,ToCityID,Distance\n";
+        for (int i = 0; i < orders.size(); i++) {
+            file << orders[i].riderID << "," << orders[i].fromCityID << ","
+                 << orders[i].toCityID << "," << orders[i].distance << "\n";
+        }
+        file.close();
+    }
+    
+    inline void saveLinehaulOrders(const string& filename, const Vector<LinehaulOrder>& orders) {
+ofstream file(filename);
+        if (!file.is_open()) return;
+        
+        file << "OrderID,FromCityID,ToCityID,Distance,Kilograms,Corridor,TrackingIDs\n";
+        for (int i = 0; i < orders.size(); i++) {
+            const LinehaulOrder& order = orders[i];
+            file << order.orderID << "," << order.fromCityID << "," << order.toCityID << ","
+                 << order.distance << "," << order.kilograms << ",";
+            for (int j = 0; j < order.corridor.size(); j++) {
+                if (j > 0) file << "|";
+                file << order.corridor[j];
+            }
+            file << ",";
+            for (int j = 0; j < order.trackingIDs.size(); j++) {
+                if (j > 0) file << "|";
+                file << order.trackingIDs[j];
+            }
+            file << "\n";
+        }
+        file.close();
+    }
+    
+    inline void loadContainers(const string& filename, Vector<Container>& containers, int& nextContainerID) {
+ifstream file(filename);
+        if (!file.is_open()) return;
+        
+string line;
+        getline(file, line);
+        while (getline(file, line)) {
+            if (line.empty()) continue;
+            auto tokens = split(line, ',');
+            if (tokens.size() < 4) continue;
+            
+            Container container(stoi(tokens[0]), static_cast<ContainerType>(stoi(tokens[1])), stoi(tokens[3]));
+            container.parentID = stoi(tokens[2]);
+            if (tokens.size() >= 5 && !tokens[4].empty()) {
+                for (const string& id : split(tokens[4], '|')) {
+                    container.parcels.push_back(stoi(id));
+                }
+            }
+            containers.push_back(container);
+            if (container.containerID >= nextContainerID) nextContainerID = container.containerID + 1;
+        }
+        file.close();
+    }
+    
+    inline void saveContainers(const string& filename, const Vector<Container>& containers) {
+ofstream file(filename);
+        if (!file.is_open()) return;
+        
+        file << "ContainerID,Type,ParentID,CurrentCityID,Parcels\n";
+        for (int i = 0; i < containers.size(); i++) {
+            const Container& container = containers[i];
+            file << container.containerID << "," << static_cast<int>(container.type) << ","
+                 << container.parentID << "," << container.currentCityID << ",";
+            for (int j = 0; j < container.parcels.size(); j++) {
+                if (j > 0) file << "|";
+                file << container.parcels[j];
+            }
+            file << "\n";
+        }
+        file.close();
+    }
+    
+    inline void loadContainerJournal(const string& filename, Vector<ContainerEvent>& events) {
+ifstream file(filename);
+        if (!file.is_open()) return;
+        
+string line;
+        getline(file, line);
+        while (getline(file, line)) {
+            if (line.empty()) continue;
+            auto tokens = split(line, ',');
+            if (tokens.size() < 5) continue;
+            events.push_back(ContainerEvent(tokens[0], stoi(tokens[1]), stoi(tokens[2]), stoi(tokens[3]), tokens[4]));
+        }
+        file.close();
+    }
+    
+    inline void appendContainerJournal(const string& filename, const Vector<ContainerEvent>& events) {
+        bool isNew = !ifstream(filename).good();
 ofstream file(filename, ios::app);
         if (file.is_open()) {
-            file << src << "," << dest << "," << dist << "\n";
+            if (isNew) file << "Op,ContainerID,Arg,CityID,Timestamp\n";
+            for (int i = 0; i < events.size(); i++) {
+                file << events[i].op << "," << events[i].containerID << "," << events[i].arg << ","
+                     << events[i].cityID << "," << events[i].timestamp << "\n";
+            }
             file.close();
         }
     }
     
+    inline void clearContainerJournal(const string& filename) {
+ofstream file(filename);
+        if (file.is_open()) {
+            file << "Op,ContainerID,Arg,CityID,Timestamp\n";
+            file.close();
+        }
+    }
     
     inline void loadRiders(const string& filename, Vector<Rider>& riders, int& nextRiderID) {
 ifstream file(filename);
@@ -402,6 +847,7 @@ string receiver = tokens[2];
                 
                 
                 if (tokens.size() > 9 && !tokens[9].empty()) {
+                    p.history = LinkedList<string>();
 string historyStr = tokens[9];
 istringstream histStream(historyStr);
 string event;
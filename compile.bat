@@ -8,7 +8,7 @@ where g++ >nul 2>&1
 if %ERRORLEVEL% == 0 (
     echo [INFO] Using MinGW g++ compiler...
     echo.
-    g++ -std=c++11 -O2 -Wall -o courier_app.exe main.cpp CourierSystem.cpp
+    g++ -std=c++11 -O2 -Wall -pthread -o courier_app.exe main.cpp CourierSystem.cpp
     if %ERRORLEVEL% == 0 (
         echo.
         echo [SUCCESS] Compilation successful!
@@ -49,7 +49,7 @@ where clang++ >nul 2>&1
 if %ERRORLEVEL% == 0 (
     echo [INFO] Using Clang++ compiler...
     echo.
-    clang++ -std=c++11 -O2 -Wall -o courier_app.exe main.cpp CourierSystem.cpp
+    clang++ -std=c++11 -O2 -Wall -pthread -o courier_app.exe main.cpp CourierSystem.cpp
     if %ERRORLEVEL% == 0 (
         echo.
         echo [SUCCESS] Compilation successful!
@@ -69,12 +69,12 @@ if %ERRORLEVEL% == 0 (
 echo [ERROR] No C++ compiler found!
 echo.
 echo Please install one of the following:
-echo   - MinGW-w64 (g++)
+echo   - MinGW-w64 (g++, posix threads)
 echo   - Microsoft Visual Studio (cl.exe)
 echo   - Clang (clang++)
 echo.
 echo Or manually compile with:
-echo   g++ -std=c++11 -O2 -Wall -o courier_app.exe main.cpp CourierSystem.cpp
+echo   g++ -std=c++11 -O2 -Wall -pthread -o courier_app.exe main.cpp CourierSystem.cpp
 echo.
 pause
 exit /b 1
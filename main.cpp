@@ -153,6 +153,22 @@ void printRoutingMenu() {
     t.addRow({"10", "View Overloaded Routes"});
     t.addRow({"11", "Add New City"});
     t.addRow({"12", "Add New Route"});
+    t.addRow({"13", "Find Fastest Route by Departure Time"});
+    t.addRow({"14", "View Route Trade-offs (Distance vs Congestion)"});
+    t.addRow({"15", "Set Route Capacity"});
+    t.addRow({"16", "Apply Bulk Network Edits from File"});
+    t.addRow({"17", "View Critical Roads & Junctions"});
+    t.addRow({"18", "Analyze Road Criticality (What-If Closures)"});
+    t.addRow({"19", "View Service Area from City"});
+    t.addRow({"20", "View All Hub Service Areas"});
+    t.addRow({"21", "Register Hub City"});
+    t.addRow({"22", "Find Route via Sorting Hub"});
+    t.addRow({"23", "Import Road Network (CSV/Binary)"});
+    t.addRow({"24", "Benchmark Node Ordering"});
+    t.addRow({"25", "Partition Network into Regions"});
+    t.addRow({"26", "Find Route via Regional Tables"});
+    t.addRow({"27", "Find Nearest Hub to Coordinates"});
+    t.addRow({"28", "Resolve Hubs for Coordinate File"});
     t.addRow({"0", "Back to Main Menu"});
     
     t.print();
@@ -179,6 +195,20 @@ void printOperationsMenu() {
     t.addRow({"8", "Record Unloading"});
     t.addRow({"9", "Record Delivery Attempt"});
     t.addRow({"10", "Return to Sender"});
+    t.addRow({"11", "Toggle Congestion-Aware Assignment"});
+    t.addRow({"12", "View Traffic Assignment Flows"});
+    t.addRow({"13", "Toggle Road-Distance Rider Matching"});
+    t.addRow({"14", "Batch Assign Riders (Warehouse -> Transit)"});
+    t.addRow({"15", "Plan Line-Haul Consolidation"});
+    t.addRow({"16", "Dispatch Line-Haul Loads"});
+    t.addRow({"17", "Create Container (Bag/Cage/Truck)"});
+    t.addRow({"18", "Pack Parcels into Container"});
+    t.addRow({"19", "Place Container Inside Another"});
+    t.addRow({"20", "Scan Container Loading"});
+    t.addRow({"21", "Scan Container Unloading"});
+    t.addRow({"22", "Empty Container"});
+    t.addRow({"23", "View Containers"});
+    t.addRow({"24", "View Container Contents"});
     t.addRow({"0", "Back to Main Menu"});
     
     t.print();
@@ -199,6 +229,18 @@ void printRiderMenu() {
     t.addRow({"2", "View All Riders"});
     t.addRow({"3", "View Rider Load"});
     t.addRow({"4", "View All Rider Loads"});
+    t.addRow({"5", "Find Nearest Riders to City"});
+    t.addRow({"6", "Plan Multi-Stop Delivery Tours"});
+    t.addRow({"7", "View Rider Tour"});
+    t.addRow({"8", "Plan Fleet Rebalancing"});
+    t.addRow({"9", "Apply Relocation Orders"});
+    t.addRow({"10", "Start/Stop Rider Location Feed"});
+    t.addRow({"11", "View Location Feed Status"});
+    t.addRow({"12", "Add Rider Shift or Break"});
+    t.addRow({"13", "Clear Rider Schedule"});
+    t.addRow({"14", "View Rider Schedule"});
+    t.addRow({"15", "Find Riders Free in City"});
+    t.addRow({"16", "Set Dispatch Clock"});
     t.addRow({"0", "Back to Main Menu"});
     
     t.print();
@@ -411,10 +453,19 @@ cin >> d;
                 system.displayOverloadedRoutes();
                 break;
             case 11: { 
-string name;
+string name, latText;
 cout << "Enter New City Name: ";
 cin >> name;
-                system.addCity(name);
+cout << "Enter Latitude (or 'n' to skip coordinates): ";
+cin >> latText;
+                if (latText == "n" || latText == "N") {
+                    system.addCity(name);
+                } else {
+                    double lon;
+cout << "Enter Longitude: ";
+cin >> lon;
+                    system.addCity(name, atof(latText.c_str()), lon);
+                }
                 break;
             }
             case 12: { 
@@ -429,6 +480,151 @@ cin >> dist;
                 system.addRoute(s, d, dist);
                 break;
             }
+            case 13: { 
+                int s, d, hour, minute;
+                system.displayCities();
+cout << "Enter Source ID: ";
+cin >> s;
+cout << "Enter Destination ID: ";
+cin >> d;
+cout << "Enter Departure Hour (0-23): ";
+cin >> hour;
+cout << "Enter Departure Minute (0-59): ";
+cin >> minute;
+                system.displayTimeDependentRoute(s, d, hour, minute);
+                break;
+            }
+            case 14: { 
+                int s, d, k;
+                system.displayCities();
+cout << "Enter Source ID: ";
+cin >> s;
+cout << "Enter Destination ID: ";
+cin >> d;
+cout << "Enter maximum number of trade-off routes (max 8): ";
+cin >> k;
+                if (k > 8) k = 8;
+                if (k < 1) k = 1;
+                system.displayAlternativeRoutes(s, d, k, true);
+                break;
+            }
+            case 15: { 
+                int s, d, capacity;
+                system.displayCities();
+cout << "Enter Source ID: ";
+cin >> s;
+cout << "Enter Destination ID: ";
+cin >> d;
+cout << "Enter Capacity (parcels): ";
+cin >> capacity;
+                system.setRouteCapacity(s, d, capacity);
+                break;
+            }
+            case 16: { 
+string filename;
+cout << "Enter Edits File (Action,SrcID,DestID,Value): ";
+cin >> filename;
+                system.applyNetworkEditsFromFile(filename);
+                break;
+            }
+            case 17:
+                system.displayNetworkVulnerabilities();
+                break;
+            case 18: { 
+                int topN;
+cout << "Enter number of roads to show: ";
+cin >> topN;
+                if (topN < 1) topN = 10;
+                system.analyzeRoadCriticality(topN);
+                break;
+            }
+            case 19: { 
+                int hub, radius;
+                system.displayCities();
+cout << "Enter Hub City ID: ";
+cin >> hub;
+cout << "Enter Radius (km): ";
+cin >> radius;
+                system.displayServiceArea(hub, radius);
+                break;
+            }
+            case 20: { 
+                int radius;
+cout << "Enter Radius (km): ";
+cin >> radius;
+                system.displayHubServiceAreas(radius);
+                break;
+            }
+            case 21: { 
+                int hub;
+                system.displayCities();
+cout << "Enter City ID: ";
+cin >> hub;
+                system.addHub(hub);
+                break;
+            }
+            case 22: { 
+                int s, d, hub;
+                system.displayCities();
+cout << "Enter Source ID: ";
+cin >> s;
+cout << "Enter Destination ID: ";
+cin >> d;
+cout << "Enter Hub City ID (-1 for best registered hub): ";
+cin >> hub;
+                system.displayViaHubRoute(s, d, hub);
+                break;
+            }
+            case 23: { 
+string filename;
+cout << "Enter Edge List File (.csv or .bin): ";
+cin >> filename;
+                system.importRoadNetwork(filename);
+                break;
+            }
+            case 24: { 
+                int cities, queries;
+cout << "Enter number of synthetic cities: ";
+cin >> cities;
+cout << "Enter number of queries: ";
+cin >> queries;
+                if (cities < 4) cities = 4;
+                system.benchmarkNodeOrdering(cities, queries);
+                break;
+            }
+            case 25: { 
+                int count;
+cout << "Enter number of regions: ";
+cin >> count;
+                system.partitionNetwork(count);
+                break;
+            }
+            case 26: { 
+                int s, d;
+                system.displayCities();
+cout << "Enter Source ID: ";
+cin >> s;
+cout << "Enter Destination ID: ";
+cin >> d;
+                system.displayRegionalRoute(s, d);
+                break;
+            }
+            case 27: { 
+                double lat, lon;
+cout << "Enter Latitude: ";
+cin >> lat;
+cout << "Enter Longitude: ";
+cin >> lon;
+                system.displayNearestHub(lat, lon);
+                break;
+            }
+            case 28: { 
+string filename;
+cout << "Enter Coordinates File (Latitude,Longitude): ";
+cin >> filename;
+                system.resolveHubsFromFile(filename);
+                break;
+            }
             default:
         cout << BRIGHT_RED << "[ERROR] Invalid Option!" << RESET << "\n";
         }
@@ -511,6 +707,94 @@ cin >> id;
                 system.returnToSender(id);
                 break;
             }
+            case 11:
+                system.setTrafficAssignmentMode(!system.isTrafficAssignmentEnabled());
+                break;
+            case 12:
+                system.displayTrafficAssignment();
+                break;
+            case 13:
+                system.setRoadMatchingMode(!system.isRoadMatchingEnabled());
+                break;
+            case 14: {
+                int limit;
+                cout << BRIGHT_CYAN << "Parcels to dispatch (0 = whole warehouse): " << RESET;
+cin >> limit;
+                system.batchAssignRiders(limit);
+                break;
+            }
+            case 15: {
+                int capacity;
+                cout << BRIGHT_CYAN << "Truck capacity in kg (0 = default): " << RESET;
+cin >> capacity;
+                system.planLinehaulConsolidation(capacity);
+                break;
+            }
+            case 16:
+                system.dispatchLinehaulOrders();
+                break;
+            case 17: {
+                int type, cityID;
+cout << "Container Type (1=Bag, 2=Cage, 3=Truck): ";
+cin >> type;
+                system.displayCities();
+cout << "Enter City ID: ";
+cin >> cityID;
+                system.createContainer(static_cast<ContainerType>(type), cityID);
+                break;
+            }
+            case 18: {
+                int containerID, id;
+                Vector<int> ids;
+                cout << BRIGHT_CYAN << "Enter Container ID: " << RESET;
+cin >> containerID;
+cout << "Enter Tracking IDs (0 to finish): ";
+                while (cin >> id && id != 0) {
+                    ids.push_back(id);
+                }
+                system.packParcels(containerID, ids);
+                break;
+            }
+            case 19: {
+                int childID, parentID;
+                system.displayContainers();
+cout << "Enter Container ID to place: ";
+cin >> childID;
+cout << "Enter Outer Container ID: ";
+cin >> parentID;
+                system.nestContainer(childID, parentID);
+                break;
+            }
+            case 20:
+            case 21: {
+                int containerID, cityID;
+                system.displayContainers();
+cout << "Enter Container ID: ";
+cin >> containerID;
+                system.displayCities();
+cout << "Enter City ID: ";
+cin >> cityID;
+                system.scanContainer(containerID, cityID, choice == 20);
+                break;
+            }
+            case 22: {
+                int containerID;
+                system.displayContainers();
+cout << "Enter Container ID: ";
+cin >> containerID;
+                system.emptyContainer(containerID);
+                break;
+            }
+            case 23:
+                system.displayContainers();
+                break;
+            case 24: {
+                int containerID;
+                cout << BRIGHT_CYAN << "Enter Container ID: " << RESET;
+cin >> containerID;
+                system.displayContainerContents(containerID);
+                break;
+            }
             default:
         cout << BRIGHT_RED << "[ERROR] Invalid Option!" << RESET << "\n";
         }
@@ -561,6 +845,117 @@ cin >> riderID;
             case 4:
                 system.displayAllRiderLoads();
                 break;
+            case 5: {
+                int cityID, weight, count;
+                system.displayCities();
+cout << "Enter Pickup City ID: ";
+cin >> cityID;
+cout << "Enter Required Capacity (kg): ";
+cin >> weight;
+cout << "How many riders: ";
+cin >> count;
+                system.displayNearestRiders(cityID, weight, count);
+                break;
+            }
+            case 6: {
+                int budget;
+cout << "Time budget per rider (ms): ";
+cin >> budget;
+                system.planRiderTours(budget);
+                break;
+            }
+            case 7: {
+                int riderID;
+                system.displayRiders();
+cout << "Enter Rider ID: ";
+cin >> riderID;
+                system.displayRiderTour(riderID);
+                break;
+            }
+            case 8:
+                system.planFleetRebalancing();
+                break;
+            case 9:
+                system.applyRelocationOrders();
+                break;
+            case 10: {
+                if (system.isLocationStreamRunning()) {
+                    system.stopLocationStream();
+                    break;
+                }
+                string filename;
+cout << "Enter feed file to follow: ";
+cin >> filename;
+                system.startLocationStream(filename);
+                break;
+            }
+            case 11:
+                system.displayLocationStreamStatus();
+                break;
+            case 12: {
+                int riderID, kind, startHour, startMinute, endHour, endMinute;
+                system.displayRiders();
+cout << "Enter Rider ID: ";
+cin >> riderID;
+cout << "Type (1=Shift, 2=Break): ";
+cin >> kind;
+cout << "Start Hour (0-23): ";
+cin >> startHour;
+cout << "Start Minute (0-59): ";
+cin >> startMinute;
+cout << "End Hour (0-23): ";
+cin >> endHour;
+cout << "End Minute (0-59): ";
+cin >> endMinute;
+                system.addRiderShift(riderID, startHour * 60 + startMinute, endHour * 60 + endMinute, kind == 2);
+                break;
+            }
+            case 13: {
+                int riderID;
+                system.displayRiders();
+cout << "Enter Rider ID: ";
+cin >> riderID;
+                system.clearRiderShifts(riderID);
+                break;
+            }
+            case 14: {
+                int riderID;
+                system.displayRiders();
+cout << "Enter Rider ID: ";
+cin >> riderID;
+                system.displayRiderShifts(riderID);
+                break;
+            }
+            case 15: {
+                int cityID, fromHour, fromMinute, toHour, toMinute, weight;
+                system.displayCities();
+cout << "Enter City ID: ";
+cin >> cityID;
+cout << "From Hour (0-23): ";
+cin >> fromHour;
+cout << "From Minute (0-59): ";
+cin >> fromMinute;
+cout << "To Hour (0-23): ";
+cin >> toHour;
+cout << "To Minute (0-59): ";
+cin >> toMinute;
+cout << "Required Capacity (kg): ";
+cin >> weight;
+                system.displayRidersFreeBetween(cityID, fromHour * 60 + fromMinute, toHour * 60 + toMinute, weight);
+                break;
+            }
+            case 16: {
+                int hour, minute;
+cout << "Dispatch Hour (0-23, or -1 for system clock): ";
+cin >> hour;
+                minute = 0;
+                if (hour >= 0) {
+cout << "Dispatch Minute (0-59): ";
+cin >> minute;
+                }
+                system.setDispatchClock(hour < 0 ? -1 : hour * 60 + minute);
+                break;
+            }
             default:
         cout << BRIGHT_RED << "[ERROR] Invalid Option!" << RESET << "\n";
         }